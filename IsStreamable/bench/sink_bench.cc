@@ -0,0 +1,101 @@
+/*
+ * Compares the throughput of FormatSink with std::ostringstream, each reused
+ *   across messages (as a logger's per-thread buffer would be), formatting
+ *   the same values: integers, doubles, strings, a mixed log line, and a type
+ *   with only an operator<< (FormatSink's fallback path).
+ */
+
+#include "FormatSink.hh"
+#include "benchUtils.hh"
+
+#include <cstddef>   // size_t
+#include <ostream>
+#include <sstream>
+#include <string>
+
+
+namespace {
+
+constexpr std::size_t message_ct { 1 << 20 };
+
+struct Point {
+    int x;
+    int y;
+};
+
+std::ostream& operator<<(std::ostream& os, const Point& p) {
+    return os << '(' << p.x << ", " << p.y << ')';
+}
+
+const std::string component { "scheduler" };
+
+// writes one message of each kind to `out`, by `i`
+template<typename OutT>
+void writeInts(OutT& out, const std::size_t i) {
+    const int n { static_cast<int>(i) };
+    out << n << ' ' << -n << ' ' << (n % 65536) * 7919 << ' ' << i << '\n';
+}
+
+template<typename OutT>
+void writeDoubles(OutT& out, const std::size_t i) {
+    const double d { static_cast<double>(i) };
+    out << d * 0.001 << ' ' << d / 3 << ' ' << 1e6 + d << '\n';
+}
+
+template<typename OutT>
+void writeStrings(OutT& out, std::size_t) {
+    out << "component=" << component << " state=" << "running" << '\n';
+}
+
+template<typename OutT>
+void writeLogLine(OutT& out, const std::size_t i) {
+    out << "[" << component << "] task " << i << " took " <<
+        static_cast<double>(i % 1000) * 0.37 << "ms, ok=" << (i % 3 != 0) <<
+        '\n';
+}
+
+template<typename OutT>
+void writePoints(OutT& out, const std::size_t i) {
+    const int n { static_cast<int>(i) };
+    out << "at " << Point { n, -n } << '\n';
+}
+
+template<typename WriteF>
+void benchPair(const char* sink_label, const char* stream_label,
+               WriteF&& write) {
+    printResult(sink_label, nsPerOp([&](std::size_t iterations) {
+        FormatSink sink;
+        std::size_t total { 0 };
+        for (std::size_t i { 0 }; i < iterations; ++i) {
+            sink.clear();
+            write(sink, i);
+            total += sink.size();
+        }
+        doNotOptimize(total);
+    }, message_ct));
+    printResult(stream_label, nsPerOp([&](std::size_t iterations) {
+        std::ostringstream os;
+        std::size_t total { 0 };
+        for (std::size_t i { 0 }; i < iterations; ++i) {
+            os.str({});
+            write(os, i);
+            total += static_cast<std::size_t>(os.tellp());
+        }
+        doNotOptimize(total);
+    }, message_ct));
+}
+
+}  // namespace
+
+int main() {
+    benchPair("ints FormatSink", "ints ostringstream",
+              [](auto& out, std::size_t i) { writeInts(out, i); });
+    benchPair("doubles FormatSink", "doubles ostringstream",
+              [](auto& out, std::size_t i) { writeDoubles(out, i); });
+    benchPair("strings FormatSink", "strings ostringstream",
+              [](auto& out, std::size_t i) { writeStrings(out, i); });
+    benchPair("log line FormatSink", "log line ostringstream",
+              [](auto& out, std::size_t i) { writeLogLine(out, i); });
+    benchPair("operator<< fallback FormatSink", "operator<< ostringstream",
+              [](auto& out, std::size_t i) { writePoints(out, i); });
+}
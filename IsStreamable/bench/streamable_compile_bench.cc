@@ -0,0 +1,73 @@
+/*
+ * Tests TYPE_CT distinct types (rounded up to a multiple of 64) for
+ *   streamability, half of them with an operator<<, to measure the compile
+ *   time and memory per test, as compiled by the compile_bench target with
+ *   TYPE_CT set by the ISSTREAMABLE_COMPILE_BENCH_TYPE_CT cache variable. As
+ *   C++20 the IsStreamable concept is tested, otherwise is_streamable_v.
+ */
+
+#include "IsStreamable.hh"
+
+#include <cstddef>      // size_t
+#include <cstdio>       // printf
+#include <ostream>
+#include <type_traits>  // conditional_t
+#include <utility>      // index_sequence
+
+#ifndef TYPE_CT
+#define TYPE_CT 1024
+#endif
+
+
+namespace {
+
+constexpr std::size_t block_sz { 64 };
+
+template <std::size_t N>
+struct Printable {
+    // hidden friend, found only by ADL on Printable<N>
+    friend std::ostream& operator<<(std::ostream& os, const Printable&) {
+        return os << N;
+    }
+};
+
+template <std::size_t N>
+struct Opaque {};
+
+template <std::size_t N>
+using Tested = std::conditional_t<N % 2 == 0, Printable<N>, Opaque<N>>;
+
+template <typename T>
+constexpr bool streamable() {
+#if __cplusplus >= 202002L
+    return IsStreamable<std::ostream, T>;
+#else
+    return is_streamable_v<std::ostream, T>;
+#endif
+}
+
+// in blocks, as one fold over thousands of types compiles in quadratic time
+template <std::size_t Block, std::size_t ...Is>
+constexpr std::size_t countBlock(std::index_sequence<Is...>) {
+    return (std::size_t { 0 } + ... +
+            streamable<Tested<Block * block_sz + Is>>());
+}
+
+template <std::size_t ...Blocks>
+constexpr std::size_t countStreamable(std::index_sequence<Blocks...>) {
+    return (std::size_t { 0 } + ... +
+            countBlock<Blocks>(std::make_index_sequence<block_sz> {}));
+}
+
+constexpr std::size_t block_ct { (TYPE_CT + block_sz - 1) / block_sz };
+constexpr std::size_t streamable_ct {
+    countStreamable(std::make_index_sequence<block_ct> {}) };
+static_assert(streamable_ct == block_ct * block_sz / 2,
+              "Expected exactly the even-numbered types to be streamable.");
+
+}  // namespace
+
+int main() {
+    std::printf("%zu of %zu types streamable\n", streamable_ct,
+                block_ct * block_sz);
+}
@@ -0,0 +1,271 @@
+#ifndef FORMATSINK_HH
+#define FORMATSINK_HH
+
+
+#if __cplusplus < 201703L
+
+#error "FormatSink.hh requires compilation as C++17 or higher"
+
+#else   // C++17 and above
+
+#include "IsStreamable.hh"
+
+#include <charconv>     // chars_format, to_chars
+#include <cstddef>      // size_t
+#include <cstring>      // memcpy, strlen
+#include <limits>
+#include <memory>       // unique_ptr
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>      // exchange
+
+#if !defined(__cpp_lib_to_chars)
+#include <cstdio>       // snprintf
+#endif
+
+
+namespace impl {
+
+template<typename T>
+constexpr bool is_narrow_char_v = std::is_same_v<T, char> ||
+    std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>;
+
+// integral types std::ostream prints as numbers
+template<typename T>
+constexpr bool is_formatted_integral_v = std::is_integral_v<T> &&
+    !std::is_same_v<T, bool> && !is_narrow_char_v<T> &&
+    !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char16_t> &&
+#if defined(__cpp_char8_t)
+    !std::is_same_v<T, char8_t> &&
+#endif
+    !std::is_same_v<T, char32_t>;
+
+template<typename T>
+constexpr bool is_c_string_v = std::is_same_v<std::decay_t<T>, char*> ||
+    std::is_same_v<std::decay_t<T>, const char*>;
+
+template<typename T>
+constexpr bool is_string_v = std::is_same_v<T, std::string> ||
+    std::is_same_v<T, std::string_view>;
+
+template<typename T>
+constexpr bool is_ostreamable_v =
+#if __cplusplus >= 202002L
+    IsOutputStreamable<std::ostream, const T>;
+#else
+    is_output_streamable<std::ostream, const T>::value;
+#endif
+
+}  // namespace impl
+
+/*
+ * @brief Formats values into a contiguous, growable char buffer, as a
+ *   default-constructed std::ostream would print them: arithmetic types by
+ *   std::to_chars and strings by memcpy, bypassing the locale, sentry and
+ *   virtual streambuf calls of each std::ostream `<<`; other types that are
+ *   output-streamable go through their operator<<, on an ostream writing
+ *   into the same buffer.
+ *
+ * @notes Floating point values are printed as `%g` with precision 6, as by
+ *   an ostream's defaults; format flags and manipulators are not supported.
+ *   Null C-strings print nothing (where an ostream would set badbit).
+ */
+class FormatSink {
+public:
+    explicit FormatSink(const std::size_t capacity = 256) :
+        chars { new char[capacity] }, cap { capacity } {}
+
+    FormatSink(FormatSink&& other) noexcept :
+        chars { std::move(other.chars) },
+        len { std::exchange(other.len, 0) },
+        cap { std::exchange(other.cap, 0) },
+        fallback { std::move(other.fallback) } {
+        if (fallback)
+            fallback->buf.sink = this;
+    }
+
+    FormatSink& operator=(FormatSink&& other) noexcept {
+        if (this != &other) {
+            chars = std::move(other.chars);
+            len = std::exchange(other.len, 0);
+            cap = std::exchange(other.cap, 0);
+            fallback = std::move(other.fallback);
+            if (fallback)
+                fallback->buf.sink = this;
+        }
+        return *this;
+    }
+
+    FormatSink(const FormatSink&) = delete;
+    FormatSink& operator=(const FormatSink&) = delete;
+
+    template<typename T>
+    FormatSink& operator<<(const T& value) {
+        static_assert(!std::is_function_v<T>,
+                      "FormatSink does not support stream manipulators.");
+        if constexpr (std::is_same_v<T, bool>) {
+            put(value ? '1' : '0');
+        } else if constexpr (impl::is_narrow_char_v<T>) {
+            put(static_cast<char>(value));
+        } else if constexpr (impl::is_formatted_integral_v<T>) {
+            // sign plus digits10 + 1 digits
+            toChars(std::numeric_limits<T>::digits10 + 2, value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            writeFloat(value);
+        } else if constexpr (impl::is_c_string_v<T>) {
+            const char* const str { value };
+            if (str != nullptr)
+                append(str, std::strlen(str));
+        } else if constexpr (impl::is_string_v<T>) {
+            append(value.data(), value.size());
+        } else {
+            static_assert(impl::is_ostreamable_v<T>,
+                          "T must have a fast path or an operator<<.");
+            writeStreamed(value);
+        }
+        return *this;
+    }
+
+    void put(const char c) {
+        if (len == cap)
+            grow(1);
+        chars[len++] = c;
+    }
+
+    void append(const char* const str, const std::size_t str_sz) {
+        if (cap - len < str_sz)
+            grow(str_sz);
+        std::memcpy(chars.get() + len, str, str_sz);
+        len += str_sz;
+    }
+
+    // ensures room for `extra` more chars without reallocating
+    void reserve(const std::size_t extra) {
+        if (cap - len < extra)
+            grow(extra);
+    }
+
+    const char* data() const { return chars.get(); }
+    std::size_t size() const { return len; }
+    std::size_t capacity() const { return cap; }
+    bool empty() const { return len == 0; }
+
+    std::string_view view() const { return { chars.get(), len }; }
+    std::string str() const { return { chars.get(), len }; }
+
+    // empties the buffer, keeping its capacity
+    void clear() { len = 0; }
+
+private:
+    /*
+     * @brief Streambuf whose put area is the free tail of the sink's buffer,
+     *   so that operator<< writes in place; begin() and end() bracket each
+     *   write.
+     */
+    class Streambuf final : public std::streambuf {
+    public:
+        explicit Streambuf(FormatSink& sink) : sink { &sink } {}
+
+        void begin() {
+            setp(sink->chars.get() + sink->len, sink->chars.get() + sink->cap);
+        }
+
+        void end() {
+            sink->len = static_cast<std::size_t>(pptr() - sink->chars.get());
+            setp(nullptr, nullptr);
+        }
+
+        FormatSink* sink;
+
+    protected:
+        int_type overflow(const int_type c) override {
+            end();
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+                sink->put(traits_type::to_char_type(c));
+            begin();
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char* const str,
+                               const std::streamsize str_sz) override {
+            end();
+            sink->append(str, static_cast<std::size_t>(str_sz));
+            begin();
+            return str_sz;
+        }
+    };
+
+    struct Fallback {
+        explicit Fallback(FormatSink& sink) : buf { sink }, os { &buf } {}
+
+        Streambuf buf;
+        std::ostream os;
+    };
+
+    void grow(const std::size_t extra) {
+        std::size_t new_cap { cap * 2 };
+        if (new_cap < len + extra)
+            new_cap = len + extra;
+        std::unique_ptr<char[]> new_chars { new char[new_cap] };
+        if (len != 0)
+            std::memcpy(new_chars.get(), chars.get(), len);
+        chars = std::move(new_chars);
+        cap = new_cap;
+    }
+
+    template<typename T>
+    void toChars(const std::size_t max_sz, const T value) {
+        reserve(max_sz);
+        const std::to_chars_result result {
+            std::to_chars(chars.get() + len, chars.get() + cap, value) };
+        len = static_cast<std::size_t>(result.ptr - chars.get());
+    }
+
+    template<typename T>
+    void writeFloat(const T value) {
+        // "-1.23457e+4932" at most, plus a null for snprintf
+        constexpr std::size_t max_sz { 16 };
+        constexpr int precision { 6 };
+        reserve(max_sz + 1);
+#if defined(__cpp_lib_to_chars)
+        const std::to_chars_result result {
+            std::to_chars(chars.get() + len, chars.get() + cap, value,
+                          std::chars_format::general, precision) };
+        len = static_cast<std::size_t>(result.ptr - chars.get());
+#else
+        len += static_cast<std::size_t>(std::snprintf(
+            chars.get() + len, max_sz + 1, "%.*Lg", precision,
+            static_cast<long double>(value)));
+#endif
+    }
+
+    template<typename T>
+    void writeStreamed(const T& value) {
+        if (!fallback)
+            fallback = std::make_unique<Fallback>(*this);
+        fallback->buf.begin();
+        try {
+            fallback->os << value;
+        } catch (...) {
+            fallback->buf.end();
+            fallback->os.clear();
+            throw;
+        }
+        fallback->buf.end();
+        fallback->os.clear();
+    }
+
+    std::unique_ptr<char[]> chars;
+    std::size_t len { 0 };
+    std::size_t cap { 0 };
+    // made on first use, as constructing an ostream costs a locale lookup
+    std::unique_ptr<Fallback> fallback;
+};
+
+#endif  // C++17 and above
+
+
+#endif  // FORMATSINK_HH
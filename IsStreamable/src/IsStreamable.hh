@@ -2,13 +2,13 @@
 #define ISSTREAMABLE_HH
 
 
-#include <type_traits>  // true_type, false_type
-#include <utility>      // declval
-#include <iostream>     // basic_istream, basic_ostream
-#include <concepts>
+#include <istream>      // basic_istream
+#include <ostream>      // basic_ostream
 
 #if  __cplusplus >= 202002L
 
+#include <concepts>     // derived_from
+
 template<typename StreamT>
 concept IsInputStream = std::derived_from<
     StreamT, std::basic_istream<typename StreamT::char_type>>;
@@ -35,55 +35,53 @@ concept IsStreamable = (
 
 #else  // __cplusplus < 202002L
 
-// use of C++11 detection idiom for ostream operator adapted from:
-//   - https://stackoverflow.com/a/22759544
-// see also:
+#include <type_traits>  // conditional, false_type, true_type
+#include <utility>      // declval
+
+// use of C++11 detection idiom, by partial specialization on void_t rather
+//   than by overload resolution of test functions, which costs the compiler
+//   more per instantiation, see:
+//   - https://en.cppreference.com/w/cpp/types/void_t
 //   - https://benjaminbrock.net/blog/detection_idiom.php
 //   - https://blog.tartanllama.xyz/detection-idiom/
+// Operands are lvalues, as in the concepts above; detecting `>>` with an
+//   rvalue operand, as `std::declval<T>()` is, failed for most types.
+
+namespace impl {
+
+// std::void_t is C++17; a struct member avoids CWG 1558 in C++11 compilers
+template<typename...>
+struct make_void { typedef void type; };
+
+template<typename ...Ts>
+using void_t = typename make_void<Ts...>::type;
+
+}  // namespace impl
+
+template<typename StreamT, typename T, typename = void>
+struct is_output_streamable : public std::false_type {};
 
 template<typename StreamT, typename T>
-class is_output_streamable {
-private:
-    template<typename TestStreamT, typename TestT>
-    static auto test_ostream_op(int) -> decltype(
-        std::declval<TestStreamT&>() << std::declval<TestT>(),
-        std::true_type()
-        );
-
-    template<typename, typename>
-    static auto test_ostream_op(...) -> std::false_type;
-
-public:
-    static constexpr bool value = decltype(
-        test_ostream_op<StreamT, T>(int())
-        )::value;
-};
+struct is_output_streamable<
+    StreamT, T, impl::void_t<decltype(
+        std::declval<StreamT&>() << std::declval<T&>())>> :
+    public std::true_type {};
+
+template<typename StreamT, typename T, typename = void>
+struct is_input_streamable : public std::false_type {};
 
-// TBD: currently the detection idiom is not working for istream operators as it
-//   does for ostream ops
 template<typename StreamT, typename T>
-class is_input_streamable {
-private:
-    template<typename TestStreamT, typename TestT>
-    static auto test_istream_op(int) -> decltype(
-        std::declval<TestStreamT&>() >> std::declval<TestT>(),
-        std::true_type()
-        );
-
-    template<typename, typename>
-    static auto test_istream_op(...) -> std::false_type;
-
-public:
-    static constexpr bool value = decltype(
-        test_istream_op<StreamT, T>(int())
-        )::value;
-};
+struct is_input_streamable<
+    StreamT, T, impl::void_t<decltype(
+        std::declval<StreamT&>() >> std::declval<T&>())>> :
+    public std::true_type {};
 
+// is_output_streamable is only instantiated if is_input_streamable is false
 template<typename StreamT, typename T>
 struct is_streamable :
-    public std::integral_constant<bool,
-                                  is_input_streamable<StreamT, T>::value ||
-                                  is_output_streamable<StreamT, T>::value>
+    public std::conditional<is_input_streamable<StreamT, T>::value,
+                            std::true_type,
+                            is_output_streamable<StreamT, T>>::type
 {};
 
   #if defined(__cpp_variable_templates)  // C++14+
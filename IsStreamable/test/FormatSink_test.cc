@@ -0,0 +1,189 @@
+#if (_CATCH_VERSION_MAJOR == 3)
+  //#include <catch2/catch_version_macros.hpp>  // CATCH_VERSION_MAJOR
+  #include <catch2/catch_test_macros.hpp>     // TEST_CASE, SECTION, REQUIRE
+#elif (_CATCH_VERSION_MAJOR == 2)
+  #include <catch2/catch.hpp>
+#endif
+
+#include "FormatSink.hh"
+
+#include <cstdint>      // int64_t, uint64_t
+#include <limits>
+#include <ostream>
+#include <sstream>      // ostringstream
+#include <string>
+#include <string_view>
+#include <utility>      // move
+
+namespace {
+
+struct Point {
+    int x;
+    int y;
+};
+
+std::ostream& operator<<(std::ostream& os, const Point& p) {
+    return os << "Point(" << p.x << ", " << p.y << ", " << 0.5 << ')';
+}
+
+enum Plain { plain_a = 7 };
+enum class Scoped : short { a = -3 };
+
+std::ostream& operator<<(std::ostream& os, const Scoped s) {
+    return os << "Scoped(" << static_cast<short>(s) << ')';
+}
+
+// as printed by a default-constructed std::ostream
+template<typename T>
+std::string ostreamed(const T& value) {
+    std::ostringstream os;
+    os << value;
+    return os.str();
+}
+
+// as printed by a FormatSink starting at `capacity`
+template<typename T>
+std::string formatted(const T& value, const std::size_t capacity = 1) {
+    FormatSink sink { capacity };
+    sink << value;
+    return sink.str();
+}
+
+template<typename T>
+void requireAsOstream(const T& value) {
+    REQUIRE(formatted(value) == ostreamed(value));
+    REQUIRE(formatted(value, 256) == ostreamed(value));
+}
+
+}  // namespace
+
+TEST_CASE("Values formatted as by std::ostream",
+          "[FormatSink]")
+{
+    SECTION("Integer limits")
+    {
+        requireAsOstream(0);
+        requireAsOstream(std::numeric_limits<int>::min());
+        requireAsOstream(std::numeric_limits<int>::max());
+        requireAsOstream(std::numeric_limits<std::int64_t>::min());
+        requireAsOstream(std::numeric_limits<std::int64_t>::max());
+        requireAsOstream(std::numeric_limits<std::uint64_t>::max());
+        requireAsOstream(std::numeric_limits<short>::min());
+        requireAsOstream(std::numeric_limits<unsigned short>::max());
+        requireAsOstream(true);
+        requireAsOstream(false);
+    }
+    SECTION("Floating point values, including nan, infinities and -0.0")
+    {
+        for (const double d : { 0.0, -0.0, 0.1, 1.0 / 3, 123456.0, 1234567.0,
+                                1e300, -1e-300,
+                                std::numeric_limits<double>::quiet_NaN(),
+                                std::numeric_limits<double>::infinity(),
+                                -std::numeric_limits<double>::infinity(),
+                                std::numeric_limits<double>::denorm_min() })
+            requireAsOstream(d);
+        requireAsOstream(1.5f);
+        requireAsOstream(-std::numeric_limits<float>::max());
+        REQUIRE(formatted(-0.0) == "-0");
+    }
+    SECTION("Long double values")
+    {
+        for (const long double ld : { 3.14159265358979L, 1e4000L,
+                                      -1.23456789e-4000L,
+                                      std::numeric_limits<long double>::max(),
+                                      std::numeric_limits<long double>::lowest(),
+                                      -std::numeric_limits<long double>::infinity() })
+            requireAsOstream(ld);
+    }
+    SECTION("Character types")
+    {
+        requireAsOstream('c');
+        requireAsOstream(static_cast<signed char>('s'));
+        requireAsOstream(static_cast<unsigned char>('u'));
+        requireAsOstream('\0');
+        REQUIRE(formatted('\0').size() == 1);
+    }
+    SECTION("Strings")
+    {
+        requireAsOstream("literal");
+        requireAsOstream(std::string("string"));
+        requireAsOstream(std::string_view("string_view"));
+        const char* const c_str { "c_str" };
+        requireAsOstream(c_str);
+        char arr[8] { "array" };
+        requireAsOstream(arr);
+        const char* const null_str { nullptr };
+        REQUIRE(formatted(null_str).empty());
+    }
+    SECTION("Enums")
+    {
+        requireAsOstream(plain_a);
+        requireAsOstream(Scoped::a);
+        REQUIRE(formatted(Scoped::a) == "Scoped(-3)");
+    }
+    SECTION("Pointers")
+    {
+        int i { 0 };
+        requireAsOstream(static_cast<void*>(&i));
+        requireAsOstream(static_cast<const void*>(nullptr));
+    }
+    SECTION("Types with only an operator<<, through the fallback stream")
+    {
+        requireAsOstream(Point { 1, -2 });
+        REQUIRE(formatted(Point { 1, -2 }) == "Point(1, -2, 0.5)");
+    }
+}
+
+TEST_CASE("Buffer growth and ownership",
+          "[FormatSink]")
+{
+    SECTION("Growth from a capacity of 1, mixing fast and fallback paths")
+    {
+        FormatSink sink { 1 };
+        std::ostringstream os;
+        for (int k { 0 }; k < 1000; ++k) {
+            sink << Point { k, -k } << ' ' << k << ' ' << 0.5 * k << "\n";
+            os << Point { k, -k } << ' ' << k << ' ' << 0.5 * k << "\n";
+        }
+        REQUIRE(sink.view() == os.str());
+        REQUIRE(sink.capacity() >= sink.size());
+    }
+    SECTION("Clearing keeps the capacity")
+    {
+        FormatSink sink { 1 };
+        sink << std::string(100, 'x');
+        const std::size_t capacity { sink.capacity() };
+        sink.clear();
+        REQUIRE(sink.empty());
+        REQUIRE(sink.capacity() == capacity);
+        sink << 42;
+        REQUIRE(sink.view() == "42");
+    }
+    SECTION("Moved-to sinks keep the contents and the fallback stream")
+    {
+        FormatSink from { 1 };
+        from << Point { 1, 2 };
+        FormatSink to { std::move(from) };
+        REQUIRE(to.view() == "Point(1, 2, 0.5)");
+        to << Point { 3, 4 };
+        REQUIRE(to.view() == "Point(1, 2, 0.5)Point(3, 4, 0.5)");
+
+        FormatSink assigned { 8 };
+        assigned << 1;
+        assigned = std::move(to);
+        assigned << ' ' << Point { 5, 6 };
+        REQUIRE(assigned.view() ==
+                "Point(1, 2, 0.5)Point(3, 4, 0.5) Point(5, 6, 0.5)");
+    }
+    SECTION("Moved-from sinks are empty and usable")
+    {
+        FormatSink from { 4 };
+        from << Point { 1, 2 };
+        const FormatSink to { std::move(from) };
+        REQUIRE(from.empty());
+        REQUIRE(from.capacity() == 0);
+        from << 5 << Point { 7, 8 } << "end";
+        REQUIRE(from.view() == "5Point(7, 8, 0.5)end");
+        REQUIRE(to.view() == "Point(1, 2, 0.5)");
+    }
+}
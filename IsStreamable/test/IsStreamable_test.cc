@@ -0,0 +1,105 @@
+#if (_CATCH_VERSION_MAJOR == 3)
+  //#include <catch2/catch_version_macros.hpp>  // CATCH_VERSION_MAJOR
+  #include <catch2/catch_test_macros.hpp>     // TEST_CASE, SECTION, REQUIRE
+#elif (_CATCH_VERSION_MAJOR == 2)
+  #include <catch2/catch.hpp>
+#endif
+
+#include "IsStreamable.hh"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>  // is_same_v
+#include <utility>      // declval
+
+// outside an anonymous namespace, so that operators may be left undefined
+namespace fixtures {
+
+struct NotStreamable {};
+
+// operators accepting only rvalue operands (declared, for detection only)
+struct RvalueOnly {};
+
+std::ostream& operator<<(std::ostream& os, RvalueOnly&&);
+std::istream& operator>>(std::istream& is, RvalueOnly&&);
+
+}  // namespace fixtures
+
+namespace {
+
+using fixtures::NotStreamable;
+using fixtures::RvalueOnly;
+
+// as either the C++20 concepts or the C++17 traits report it
+template<typename T>
+constexpr bool output_streamable {
+#if __cplusplus >= 202002L
+    IsOutputStreamable<std::ostream, T>
+#else
+    is_output_streamable<std::ostream, T>::value
+#endif
+};
+
+template<typename T>
+constexpr bool input_streamable {
+#if __cplusplus >= 202002L
+    IsInputStreamable<std::istream, T>
+#else
+    is_input_streamable<std::istream, T>::value
+#endif
+};
+
+template<typename StreamT, typename T>
+constexpr bool streamable {
+#if __cplusplus >= 202002L
+    IsStreamable<StreamT, T>
+#else
+    is_streamable_v<StreamT, T>
+#endif
+};
+
+}  // namespace
+
+TEST_CASE("Detection of stream operators, with lvalue operands",
+          "[IsStreamable]")
+{
+    SECTION("Built-in types")
+    {
+        static_assert(output_streamable<int>);
+        static_assert(input_streamable<int>);
+        static_assert(streamable<std::ostream, int>);
+        static_assert(streamable<std::istream, int>);
+    }
+    SECTION("Library types")
+    {
+        static_assert(output_streamable<std::string>);
+        static_assert(input_streamable<std::string>);
+        static_assert(streamable<std::ostream, std::string>);
+    }
+    SECTION("Types without operators")
+    {
+        static_assert(!output_streamable<NotStreamable>);
+        static_assert(!input_streamable<NotStreamable>);
+        static_assert(!streamable<std::ostream, NotStreamable>);
+        static_assert(!streamable<std::istream, NotStreamable>);
+    }
+    SECTION("Types whose operators take only rvalues")
+    {
+        static_assert(std::is_same_v<decltype(std::declval<std::ostream&>()
+                                              << RvalueOnly {}),
+                                     std::ostream&>);
+        // an lvalue operand cannot bind to the operators, as in `os << obj`
+        static_assert(!output_streamable<RvalueOnly>);
+        static_assert(!input_streamable<RvalueOnly>);
+        static_assert(!streamable<std::ostream, RvalueOnly>);
+        static_assert(!streamable<std::istream, RvalueOnly>);
+    }
+    SECTION("Const operands are output- but not input-streamable")
+    {
+        static_assert(output_streamable<const int>);
+        static_assert(!input_streamable<const int>);
+        static_assert(output_streamable<const std::string>);
+        static_assert(!input_streamable<const std::string>);
+    }
+}
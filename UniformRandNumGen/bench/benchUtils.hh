@@ -0,0 +1,43 @@
+#ifndef BENCHUTILS_HH
+#define BENCHUTILS_HH
+
+
+#include <chrono>
+#include <cstddef>   // size_t
+#include <cstdio>    // printf
+
+
+/*
+ * @brief Prevents the compiler from discarding a value computed only for
+ *   timing purposes.
+ */
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+/*
+ * @brief Runs `func(iterations)` once untimed to warm caches and fault in
+ *   pages, then once timed, returning mean nanoseconds per iteration.
+ */
+template<typename FuncT>
+double nsPerOp(FuncT&& func, const std::size_t iterations) {
+    func(iterations);
+    const auto start { std::chrono::steady_clock::now() };
+    func(iterations);
+    const auto stop { std::chrono::steady_clock::now() };
+    return std::chrono::duration<double, std::nano>(stop - start).count() /
+        static_cast<double>(iterations);
+}
+
+inline void printResult(const char* label, const double ns_per_op) {
+    std::printf("%-40s %8.3f ns/op\n", label, ns_per_op);
+}
+
+
+#endif  // BENCHUTILS_HH
@@ -0,0 +1,61 @@
+/*
+ * Compares std::uniform_int_distribution with LemireUniformIntDist for single,
+ *   batched and compile-time bounded draws, over a small range typical of
+ *   index sampling and a wide one.
+ */
+
+#include "LemireUniformIntDist.hh"
+#include "Xoshiro256pp.hh"
+#include "benchUtils.hh"
+
+#include <cstdint>   // uint32_t
+#include <random>    // uniform_int_distribution
+#include <vector>
+
+
+namespace {
+
+constexpr std::size_t draw_ct { 1 << 24 };
+
+template<std::uint32_t High>
+void benchRange(const char* std_label, const char* single_label,
+                const char* batch_label, const char* fixed_label) {
+    std::vector<std::uint32_t> out(draw_ct);
+    Xoshiro256pp rng { 1 };
+    {
+        std::uniform_int_distribution<std::uint32_t> dist { 0, High };
+        printResult(std_label, nsPerOp([&](std::size_t) {
+            for (std::uint32_t& n : out)
+                n = dist(rng);
+        }, draw_ct));
+        doNotOptimize(out.back());
+    }
+    const LemireUniformIntDist<std::uint32_t> dist { 0, High };
+    printResult(single_label, nsPerOp([&](std::size_t) {
+        for (std::uint32_t& n : out)
+            n = dist(rng);
+    }, draw_ct));
+    doNotOptimize(out.back());
+    printResult(batch_label, nsPerOp([&](std::size_t) {
+        dist.generate(rng, out.begin(), out.end());
+    }, draw_ct));
+    doNotOptimize(out.back());
+    const FixedLemireUniformIntDist<std::uint32_t, 0, High> fixed_dist {};
+    printResult(fixed_label, nsPerOp([&](std::size_t) {
+        fixed_dist.generate(rng, out.begin(), out.end());
+    }, draw_ct));
+    doNotOptimize(out.back());
+}
+
+}  // namespace
+
+int main() {
+    benchRange<99>("[0, 99] std::uniform_int_distribution",
+                   "[0, 99] Lemire single",
+                   "[0, 99] Lemire batched",
+                   "[0, 99] Lemire fixed batched");
+    benchRange<3000000000>("[0, 3e9] std::uniform_int_distribution",
+                           "[0, 3e9] Lemire single",
+                           "[0, 3e9] Lemire batched",
+                           "[0, 3e9] Lemire fixed batched");
+}
@@ -0,0 +1,65 @@
+/*
+ * Compares per-draw virtual dispatch through UniformRandNumGen against the
+ *   statically dispatched StaticUniformRandNumGen family, both drawing singly
+ *   and through bulk generate().
+ */
+
+#include "UniformRandNumGen.hh"
+#include "benchUtils.hh"
+
+#include <vector>
+
+
+namespace {
+
+constexpr std::size_t draw_ct { 1 << 24 };
+
+// laundering base pointer through volatile to keep the compiler from
+//   devirtualizing
+template<typename T>
+void drawVirtual(UniformRandNumGen<T>& gen, std::vector<T>& out) {
+    UniformRandNumGen<T>* volatile base { &gen };
+    UniformRandNumGen<T>& erased { *base };
+    for (T& val : out)
+        val = erased();
+}
+
+}  // namespace
+
+int main() {
+    std::vector<int> ints(draw_ct);
+    std::vector<double> reals(draw_ct);
+
+    {
+        UniformRandIntGen<int> gen { 0, 1000 };
+        printResult("UniformRandIntGen (virtual)", nsPerOp(
+            [&](std::size_t) { drawVirtual<int>(gen, ints); }, draw_ct));
+        doNotOptimize(ints.back());
+    }
+    {
+        StaticUniformRandIntGen<int> gen { 0, 1000 };
+        printResult("StaticUniformRandIntGen operator()", nsPerOp(
+            [&](std::size_t) { for (int& n : ints) n = gen(); }, draw_ct));
+        doNotOptimize(ints.back());
+        printResult("StaticUniformRandIntGen generate", nsPerOp(
+            [&](std::size_t) { gen.generate(ints.begin(), ints.end()); },
+            draw_ct));
+        doNotOptimize(ints.back());
+    }
+    {
+        UniformRandRealGen<double> gen { 0.0, 1.0 };
+        printResult("UniformRandRealGen (virtual)", nsPerOp(
+            [&](std::size_t) { drawVirtual<double>(gen, reals); }, draw_ct));
+        doNotOptimize(reals.back());
+    }
+    {
+        StaticUniformRandRealGen<double> gen { 0.0, 1.0 };
+        printResult("StaticUniformRandRealGen operator()", nsPerOp(
+            [&](std::size_t) { for (double& d : reals) d = gen(); }, draw_ct));
+        doNotOptimize(reals.back());
+        printResult("StaticUniformRandRealGen generate", nsPerOp(
+            [&](std::size_t) { gen.generate(reals.begin(), reals.end()); },
+            draw_ct));
+        doNotOptimize(reals.back());
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Measures raw random bit throughput of std::mt19937 against the scalar and
+ *   multi-lane xoshiro256++ engines, and the effect of the engine on generator
+ *   bulk fills.
+ */
+
+#include "UniformRandNumGen.hh"
+#include "Xoshiro256pp.hh"
+#include "benchUtils.hh"
+
+#include <cstdint>   // uint32_t, uint64_t
+#include <cstdio>    // printf
+#include <vector>
+
+
+namespace {
+
+constexpr std::size_t word_ct { 1 << 22 };  // 32 MiB of 64-bit words
+
+void printBandwidth(const char* label, const double ns_per_word,
+                    const std::size_t bytes_per_word) {
+    std::printf("%-40s %8.3f ns/word %8.2f GB/s\n", label, ns_per_word,
+                static_cast<double>(bytes_per_word) / ns_per_word);
+}
+
+}  // namespace
+
+int main() {
+    {
+        std::vector<std::uint32_t> out(word_ct);
+        std::mt19937 rng { 1 };
+        printBandwidth("std::mt19937", nsPerOp([&](std::size_t) {
+            for (std::uint32_t& word : out)
+                word = rng();
+        }, word_ct), sizeof(std::uint32_t));
+        doNotOptimize(out.back());
+    }
+
+    std::vector<std::uint64_t> out(word_ct);
+    {
+        Xoshiro256pp rng { 1 };
+        printBandwidth("Xoshiro256pp", nsPerOp([&](std::size_t) {
+            for (std::uint64_t& word : out)
+                word = rng();
+        }, word_ct), sizeof(std::uint64_t));
+        doNotOptimize(out.back());
+    }
+    const struct { SimdBackend backend; const char* label; } backends[] {
+        { SimdBackend::Scalar, "Xoshiro256ppX4 fill (scalar)" },
+        { SimdBackend::SSE2,   "Xoshiro256ppX4 fill (SSE2)" },
+        { SimdBackend::AVX2,   "Xoshiro256ppX4 fill (AVX2)" }
+    };
+    for (const auto& [backend, label] : backends) {
+        Xoshiro256ppX4 rng { 1, backend };
+        if (rng.backend() != backend) {
+            std::printf("%-40s unsupported by this CPU\n", label);
+            continue;
+        }
+        printBandwidth(label, nsPerOp([&](std::size_t) {
+            rng.fill(out.data(), out.size());
+        }, word_ct), sizeof(std::uint64_t));
+        doNotOptimize(out.back());
+    }
+    {
+        Xoshiro256ppX4 rng { 1 };
+        printBandwidth("Xoshiro256ppX4 operator() (auto)", nsPerOp(
+            [&](std::size_t) {
+                for (std::uint64_t& word : out)
+                    word = rng();
+            }, word_ct), sizeof(std::uint64_t));
+        doNotOptimize(out.back());
+    }
+
+    std::vector<double> reals(word_ct);
+    {
+        StaticUniformRandRealGen<double> gen { 0.0, 1.0 };
+        printResult("StaticUniformRandRealGen<mt19937>", nsPerOp(
+            [&](std::size_t) { gen.generate(reals.begin(), reals.end()); },
+            word_ct));
+        doNotOptimize(reals.back());
+    }
+    {
+        StaticUniformRandRealGen<double, Xoshiro256ppX4> gen { 0.0, 1.0 };
+        printResult("StaticUniformRandRealGen<Xoshiro256ppX4>", nsPerOp(
+            [&](std::size_t) { gen.generate(reals.begin(), reals.end()); },
+            word_ct));
+        doNotOptimize(reals.back());
+    }
+}
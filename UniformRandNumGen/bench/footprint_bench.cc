@@ -0,0 +1,85 @@
+/*
+ * Reports per-generator memory footprint next to throughput, for a single
+ *   generator filling a buffer, for one generator per entity in a large
+ *   array (where footprint decides how many generators fit in cache), and for
+ *   the structure-of-arrays alternative of one engine per entity sharing a
+ *   single distribution.
+ */
+
+#include "UniformRandNumGen.hh"
+#include "Pcg32.hh"
+#include "SplitMix64.hh"
+#include "Xoshiro128pp.hh"
+#include "Xoshiro256pp.hh"
+#include "benchUtils.hh"
+
+#include <cstdio>       // printf
+#include <random>
+#include <type_traits>  // is_trivially_copyable_v
+#include <vector>
+
+
+namespace {
+
+constexpr std::size_t draw_ct { 1 << 22 };
+constexpr std::size_t entity_ct { 1 << 16 };
+
+template<typename EngineT>
+void benchEngine(const char* engine_name) {
+    using GenT = StaticUniformRandIntGen<int, EngineT>;
+    std::vector<int> out(draw_ct);
+    GenT single_gen { 0, 999, 1 };
+    const double single_ns { nsPerOp([&](std::size_t) {
+        single_gen.generate(out.begin(), out.end());
+    }, draw_ct) };
+    doNotOptimize(out.back());
+
+    std::vector<GenT> entity_gens;
+    entity_gens.reserve(entity_ct);
+    for (std::size_t i { 0 }; i < entity_ct; ++i)
+        entity_gens.emplace_back(0, 999, i);
+    const std::size_t pass_ct { draw_ct / entity_ct };
+    const double entity_ns { nsPerOp([&](std::size_t) {
+        for (std::size_t pass { 0 }; pass < pass_ct; ++pass) {
+            for (std::size_t i { 0 }; i < entity_ct; ++i)
+                out[i] = entity_gens[i]();
+        }
+    }, pass_ct * entity_ct) };
+    doNotOptimize(out.front());
+
+    std::vector<EngineT> entity_engines;
+    entity_engines.reserve(entity_ct);
+    for (std::size_t i { 0 }; i < entity_ct; ++i)
+        entity_engines.emplace_back(i);
+    const LemireUniformIntDist<int> shared_dist { 0, 999 };
+    const double soa_ns { nsPerOp([&](std::size_t) {
+        for (std::size_t pass { 0 }; pass < pass_ct; ++pass) {
+            for (std::size_t i { 0 }; i < entity_ct; ++i)
+                out[i] = shared_dist(entity_engines[i]);
+        }
+    }, pass_ct * entity_ct) };
+    doNotOptimize(out.front());
+
+    std::printf("%-14s %7zu B %-5s %9.3f ns/op %9.3f ns/op %9.3f ns/op\n",
+                engine_name, sizeof(GenT),
+                std::is_trivially_copyable_v<GenT> ? "yes" : "no",
+                single_ns, entity_ns, soa_ns);
+    std::printf("%-14s %7zu B %15s %8.1f MiB %8.1f MiB\n", "", sizeof(EngineT),
+                "", static_cast<double>(sizeof(GenT) * entity_ct) / (1 << 20),
+                static_cast<double>(sizeof(EngineT) * entity_ct) / (1 << 20));
+}
+
+}  // namespace
+
+int main() {
+    std::printf("%d entities; second row: engine size, memory of each array\n",
+                static_cast<int>(entity_ct));
+    std::printf("%-14s %9s %-5s %15s %15s %15s\n", "engine",
+                "gen size", "trivl", "bulk fill", "per-entity gen",
+                "per-entity SoA");
+    benchEngine<std::mt19937>("std::mt19937");
+    benchEngine<Xoshiro256pp>("Xoshiro256pp");
+    benchEngine<Xoshiro128pp>("Xoshiro128pp");
+    benchEngine<Pcg32>("Pcg32");
+    benchEngine<SplitMix64>("SplitMix64");
+}
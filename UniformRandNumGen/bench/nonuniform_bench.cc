@@ -0,0 +1,62 @@
+/*
+ * Compares std::normal_distribution, std::exponential_distribution and
+ *   std::poisson_distribution with their ziggurat and PTRS counterparts, for
+ *   single draws and bulk generate(), on the same engine.
+ */
+
+#include "PoissonDist.hh"
+#include "Xoshiro256pp.hh"
+#include "ZigguratDist.hh"
+#include "benchUtils.hh"
+
+#include <random>    // normal_distribution, exponential_distribution,
+                     //   poisson_distribution
+#include <string>
+#include <vector>
+
+
+namespace {
+
+constexpr std::size_t draw_ct { 1 << 22 };
+
+template<typename StdDistT, typename DistT, typename EngineT>
+void benchPair(const std::string& label, StdDistT std_dist, const DistT& dist) {
+    std::vector<typename DistT::result_type> out(draw_ct);
+    EngineT rng { 1 };
+    printResult((label + " std").c_str(), nsPerOp([&](std::size_t) {
+        for (auto& x : out)
+            x = std_dist(rng);
+    }, draw_ct));
+    doNotOptimize(out.back());
+    printResult((label + " single").c_str(), nsPerOp([&](std::size_t) {
+        for (auto& x : out)
+            x = dist(rng);
+    }, draw_ct));
+    doNotOptimize(out.back());
+    printResult((label + " generate").c_str(), nsPerOp([&](std::size_t) {
+        dist.generate(rng, out.begin(), out.end());
+    }, draw_ct));
+    doNotOptimize(out.back());
+}
+
+}  // namespace
+
+int main() {
+    benchPair<std::normal_distribution<double>, ZigguratNormalDist<double>,
+              Xoshiro256pp>("normal Xoshiro256pp", {}, ZigguratNormalDist<double> {});
+    benchPair<std::normal_distribution<double>, ZigguratNormalDist<double>,
+              Xoshiro256ppX4>("normal Xoshiro256ppX4", {},
+                              ZigguratNormalDist<double> {});
+    benchPair<std::exponential_distribution<double>,
+              ZigguratExponentialDist<double>, Xoshiro256pp>(
+        "exponential Xoshiro256pp", {}, ZigguratExponentialDist<double> {});
+    benchPair<std::exponential_distribution<double>,
+              ZigguratExponentialDist<double>, Xoshiro256ppX4>(
+        "exponential Xoshiro256ppX4", {}, ZigguratExponentialDist<double> {});
+    benchPair<std::poisson_distribution<int>, PoissonDist<int>, Xoshiro256pp>(
+        "poisson(4) Xoshiro256pp", std::poisson_distribution<int> { 4.0 },
+        PoissonDist<int> { 4.0 });
+    benchPair<std::poisson_distribution<int>, PoissonDist<int>, Xoshiro256pp>(
+        "poisson(100) Xoshiro256pp", std::poisson_distribution<int> { 100.0 },
+        PoissonDist<int> { 100.0 });
+}
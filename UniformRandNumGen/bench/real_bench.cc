@@ -0,0 +1,50 @@
+/*
+ * Compares std::uniform_real_distribution with MantissaUniformRealDist for
+ *   single and bulk draws of doubles and floats, from the 32-bit std::mt19937
+ *   and the 64-bit Xoshiro256pp and Xoshiro256ppX4 engines.
+ */
+
+#include "MantissaUniformRealDist.hh"
+#include "Xoshiro256pp.hh"
+#include "benchUtils.hh"
+
+#include <random>    // mt19937, uniform_real_distribution
+#include <string>
+#include <vector>
+
+
+namespace {
+
+constexpr std::size_t draw_ct { 1 << 24 };
+
+template<typename RealT, typename EngineT>
+void benchEngine(const std::string& label) {
+    std::vector<RealT> out(draw_ct);
+    EngineT rng { 1 };
+    {
+        std::uniform_real_distribution<RealT> dist { 0, 1 };
+        printResult((label + " std::uniform_real").c_str(), nsPerOp(
+            [&](std::size_t) { for (RealT& x : out) x = dist(rng); },
+            draw_ct));
+        doNotOptimize(out.back());
+    }
+    const MantissaUniformRealDist<RealT> dist { 0, 1 };
+    printResult((label + " mantissa single").c_str(), nsPerOp(
+        [&](std::size_t) { for (RealT& x : out) x = dist(rng); }, draw_ct));
+    doNotOptimize(out.back());
+    printResult((label + " mantissa generate").c_str(), nsPerOp(
+        [&](std::size_t) { dist.generate(rng, out.begin(), out.end()); },
+        draw_ct));
+    doNotOptimize(out.back());
+}
+
+}  // namespace
+
+int main() {
+    benchEngine<double, std::mt19937>("double mt19937");
+    benchEngine<double, Xoshiro256pp>("double Xoshiro256pp");
+    benchEngine<double, Xoshiro256ppX4>("double Xoshiro256ppX4");
+    benchEngine<float, std::mt19937>("float mt19937");
+    benchEngine<float, Xoshiro256pp>("float Xoshiro256pp");
+    benchEngine<float, Xoshiro256ppX4>("float Xoshiro256ppX4");
+}
@@ -0,0 +1,70 @@
+/*
+ * Measures generator construction latency and object size by seeding
+ *   strategy: a std::random_device member (the previous layout), a temporary
+ *   std::random_device (default construction), one getrandom(2) call,
+ *   processSeed(), and an explicit seed.
+ */
+
+#include "UniformRandNumGen.hh"
+#include "RandSeed.hh"
+#include "Xoshiro256pp.hh"
+#include "benchUtils.hh"
+
+#include <cstdio>    // printf
+#include <random>
+
+
+namespace {
+
+constexpr std::size_t construct_ct { 1 << 14 };
+
+// layout of UniformRandNumGen before seeding strategies were added
+struct RandomDeviceMember {
+    std::random_device rd {};
+    std::mt19937 rng { rd() };
+};
+
+template<typename EngineT>
+void benchEngine(const char* engine_name) {
+    std::printf("%s, sizeof(StaticUniformRandIntGen<int>) = %zu\n", engine_name,
+                sizeof(StaticUniformRandIntGen<int, EngineT>));
+    printResult("  temporary random_device", nsPerOp([](std::size_t n) {
+        for (; n != 0; --n) {
+            StaticUniformRandIntGen<int, EngineT> gen { 0, 99 };
+            doNotOptimize(gen());
+        }
+    }, construct_ct));
+    printResult("  getrandomSeed()", nsPerOp([](std::size_t n) {
+        for (; n != 0; --n) {
+            StaticUniformRandIntGen<int, EngineT> gen { 0, 99, getrandomSeed() };
+            doNotOptimize(gen());
+        }
+    }, construct_ct));
+    printResult("  processSeed()", nsPerOp([](std::size_t n) {
+        for (; n != 0; --n) {
+            StaticUniformRandIntGen<int, EngineT> gen { 0, 99, processSeed() };
+            doNotOptimize(gen());
+        }
+    }, construct_ct));
+    printResult("  explicit seed", nsPerOp([](std::size_t n) {
+        for (; n != 0; --n) {
+            StaticUniformRandIntGen<int, EngineT> gen { 0, 99, n };
+            doNotOptimize(gen());
+        }
+    }, construct_ct));
+}
+
+}  // namespace
+
+int main() {
+    std::printf("std::mt19937, sizeof(random_device member layout) = %zu\n",
+                sizeof(RandomDeviceMember));
+    printResult("  random_device member", nsPerOp([](std::size_t n) {
+        for (; n != 0; --n) {
+            RandomDeviceMember gen {};
+            doNotOptimize(gen.rng());
+        }
+    }, construct_ct));
+    benchEngine<std::mt19937>("std::mt19937");
+    benchEngine<Xoshiro256pp>("Xoshiro256pp");
+}
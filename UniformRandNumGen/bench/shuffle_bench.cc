@@ -0,0 +1,73 @@
+/*
+ * Compares std::shuffle with batchedShuffle and the bucketed parallelShuffle
+ *   on an array that fits in cache and one that does not, and
+ *   std::discrete_distribution with AliasTable for weighted sampling.
+ */
+
+#include "RandSampling.hh"
+#include "Xoshiro256pp.hh"
+#include "benchUtils.hh"
+
+#include <algorithm>  // shuffle
+#include <cstdint>    // uint32_t
+#include <numeric>    // iota
+#include <random>     // discrete_distribution
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+void benchShuffles(const std::size_t elem_ct) {
+    const std::string size_label { std::to_string(elem_ct) + " x uint32 " };
+    std::vector<std::uint32_t> v(elem_ct);
+    std::iota(v.begin(), v.end(), 0);
+    Xoshiro256pp rng { 1 };
+    printResult((size_label + "std::shuffle").c_str(), nsPerOp(
+        [&](std::size_t) { std::shuffle(v.begin(), v.end(), rng); }, elem_ct));
+    doNotOptimize(v.front());
+    printResult((size_label + "batchedShuffle").c_str(), nsPerOp(
+        [&](std::size_t) { batchedShuffle(v.begin(), v.end(), rng); }, elem_ct));
+    doNotOptimize(v.front());
+    printResult((size_label + "parallelShuffle 1 thread").c_str(), nsPerOp(
+        [&](std::size_t) { parallelShuffle(v.begin(), v.end(), rng, 1); },
+        elem_ct));
+    doNotOptimize(v.front());
+    const unsigned thread_ct { std::thread::hardware_concurrency() };
+    if (thread_ct <= 1)
+        return;
+    printResult((size_label + "parallelShuffle " + std::to_string(thread_ct) +
+                 " threads").c_str(), nsPerOp(
+        [&](std::size_t) { parallelShuffle(v.begin(), v.end(), rng, thread_ct); },
+        elem_ct));
+    doNotOptimize(v.front());
+}
+
+void benchWeighted() {
+    constexpr std::size_t draw_ct { 1 << 22 };
+    std::vector<double> weights(1000);
+    for (std::size_t i { 0 }; i < weights.size(); ++i)
+        weights[i] = static_cast<double>(i % 17 + 1);
+    std::vector<std::size_t> out(draw_ct);
+    Xoshiro256pp rng { 2 };
+    std::discrete_distribution<std::size_t> std_dist(weights.begin(),
+                                                     weights.end());
+    printResult("1000 weights std::discrete_distribution", nsPerOp(
+        [&](std::size_t) { for (std::size_t& i : out) i = std_dist(rng); },
+        draw_ct));
+    doNotOptimize(out.back());
+    const AliasTable table(weights.begin(), weights.end());
+    printResult("1000 weights AliasTable", nsPerOp(
+        [&](std::size_t) { table.generate(rng, out.begin(), out.end()); },
+        draw_ct));
+    doNotOptimize(out.back());
+}
+
+}  // namespace
+
+int main() {
+    benchShuffles(std::size_t{ 1 } << 16);
+    benchShuffles(std::size_t{ 1 } << 25);
+    benchWeighted();
+}
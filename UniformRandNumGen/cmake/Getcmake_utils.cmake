@@ -8,7 +8,7 @@ if(NOT cmake_utils_POPULATED)
     GIT_REPOSITORY https://github.com/allelomorph/cmake_utils.git
     # ExternalProject_Add defaults to origin/master up to at least cmake 3.30, see:
     #   - https://cmake.org/cmake/help/v3.30/module/ExternalProject.html#git
-    GIT_TAG        159bb9cb607e8e26c98ceb1ad95f7d9e9ca2a61f  # origin/main
+    GIT_TAG        4789565a240d301c185b2413a8e5c19aeb3b3257  # origin/main
   )
   FetchContent_MakeAvailable(cmake_utils)
   list(APPEND CMAKE_MODULE_PATH ${cmake_utils_SOURCE_DIR})
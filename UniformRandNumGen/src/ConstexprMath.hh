@@ -0,0 +1,76 @@
+#ifndef CONSTEXPRMATH_HH
+#define CONSTEXPRMATH_HH
+
+
+#if __cplusplus < 201703L
+#error "C++17 and above required due to use of loops in constexpr functions"
+#endif
+
+/*
+ * Compile-time exp, log and sqrt for building distribution tables, as the
+ *   <cmath> functions are not constexpr before C++26. Accurate to within a few
+ *   ulps for the finite, positive (log, sqrt) arguments the tables need; not
+ *   intended for use at runtime.
+ */
+
+namespace impl {
+
+constexpr double ln2_hi { 6.93147180369123816490e-01 };  // high bits of ln(2)
+constexpr double ln2_lo { 1.90821492927058770002e-10 };  // ln(2) - ln2_hi
+
+constexpr double constexprExp(const double x) {
+    // x = k * ln(2) + r, |r| <= ln(2) / 2, so exp(x) = 2^k * exp(r)
+    const double k_real { x / (ln2_hi + ln2_lo) };
+    const long k { static_cast<long>(k_real < 0 ? k_real - 0.5 : k_real + 0.5) };
+    const double r { (x - static_cast<double>(k) * ln2_hi) -
+                     static_cast<double>(k) * ln2_lo };
+    double term { 1 };
+    double sum { 1 };
+    for (int n { 1 }; n < 30; ++n) {
+        term *= r / n;
+        sum += term;
+    }
+    for (long i { 0 }; i < k; ++i)
+        sum *= 2;
+    for (long i { 0 }; i > k; --i)
+        sum /= 2;
+    return sum;
+}
+
+constexpr double constexprLog(double x) {
+    // x = m * 2^e, m in [sqrt(1/2), sqrt(2)), so log(x) = e * ln(2) + log(m)
+    long e { 0 };
+    for (; x >= 1.4142135623730951; x /= 2)
+        ++e;
+    for (; x < 0.70710678118654752; x *= 2)
+        --e;
+    // log(m) = 2 * atanh(z), z = (m - 1) / (m + 1), |z| < 0.172
+    const double z { (x - 1) / (x + 1) };
+    const double z_sq { z * z };
+    double power { z };
+    double sum { 0 };
+    for (int n { 1 }; n < 60; n += 2) {
+        sum += power / n;
+        power *= z_sq;
+    }
+    return static_cast<double>(e) * ln2_hi +
+        (static_cast<double>(e) * ln2_lo + 2 * sum);
+}
+
+constexpr double constexprSqrt(const double x) {
+    if (x <= 0)
+        return 0;
+    double root { x < 1 ? 1 : x };
+    for (int i { 0 }; i < 200; ++i) {
+        const double next { (root + x / root) / 2 };
+        if (next == root)
+            break;
+        root = next;
+    }
+    return root;
+}
+
+}  // namespace impl
+
+
+#endif  // CONSTEXPRMATH_HH
@@ -0,0 +1,167 @@
+#ifndef COUNTERUNIFORMRANDNUMGEN_HH
+#define COUNTERUNIFORMRANDNUMGEN_HH
+
+
+#if __cplusplus < 201703L
+#error "C++17 and above required due to use of variable templates \
+std::is_integral_v and std::is_floating_point_v"
+#endif
+
+#include "LemireUniformIntDist.hh"
+#include "MantissaUniformRealDist.hh"
+#include "Philox4x32.hh"
+
+#include <cstddef>      // size_t
+#include <cstdint>      // uint32_t, uint64_t
+#include <type_traits>  // enable_if_t, make_unsigned_t
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+/*
+ * @brief Random-access counterpart to StaticUniformRandNumGen: the value at
+ *   sequence position `index` is a pure function of (key, index), computed in
+ *   O(1) by Philox4x32.
+ *
+ * @notes Position `i` draws 64 bits from half `i % 2` of Philox block `i / 2`,
+ *   so generate() over any partition of a range of positions, in any order or
+ *   across any number of threads, is bit-identical to one sequential call.
+ *   DerivedT must provide `T fromBits(std::uint64_t index, std::uint32_t hi,
+ *   std::uint32_t lo) const`, where `index` allows deterministic redraws.
+ */
+template<typename DerivedT, typename T>
+class CounterUniformRandNumGen {
+public:
+    /*
+     * @brief Returns value at sequence position `index`.
+     */
+    T operator[](const std::uint64_t index) const {
+        const Philox4x32::counter_type blk { Philox4x32::block(key, index / 2) };
+        return (index % 2 == 0) ?
+            derived().fromBits(index, blk[0], blk[1]) :
+            derived().fromBits(index, blk[2], blk[3]);
+    }
+
+    /*
+     * @brief Writes values at positions [offset, offset + (last - first)).
+     */
+    template<typename OutputIt>
+    void generate(std::uint64_t offset, OutputIt first, OutputIt last) const {
+        if (first != last && offset % 2 != 0) {
+            *first = (*this)[offset++];
+            ++first;
+        }
+        // two positions per block in the common case
+        while (first != last) {
+            const Philox4x32::counter_type blk {
+                Philox4x32::block(key, offset / 2) };
+            *first = derived().fromBits(offset, blk[0], blk[1]);
+            if (++first == last)
+                break;
+            *first = derived().fromBits(offset + 1, blk[2], blk[3]);
+            ++first;
+            offset += 2;
+        }
+    }
+
+#if __cplusplus >= 202002L
+    void generate(std::uint64_t offset, std::span<T> out) const {
+        generate(offset, out.begin(), out.end());
+    }
+#endif
+
+    const Philox4x32::key_type& getKey() const { return key; }
+
+protected:
+    explicit CounterUniformRandNumGen(const std::uint64_t seed_val) :
+        key{ Philox4x32::keyFromSeed(seed_val) } {}
+    ~CounterUniformRandNumGen() = default;
+
+    /*
+     * @brief Further 64 bits for position `index`, from a block keyed by
+     *   `attempt` in the third counter word so as never to collide with the
+     *   blocks used for first draws.
+     */
+    std::uint64_t redrawBits(const std::uint64_t index,
+                             const std::uint32_t attempt) const {
+        const Philox4x32::counter_type blk { Philox4x32::block(
+                key, Philox4x32::counter_type{
+                    static_cast<std::uint32_t>(index),
+                    static_cast<std::uint32_t>(index >> 32), attempt, 0 }) };
+        return (std::uint64_t{ blk[0] } << 32) | blk[1];
+    }
+
+private:
+    const DerivedT& derived() const {
+        return static_cast<const DerivedT&>(*this);
+    }
+
+    Philox4x32::key_type key;
+};
+
+/*
+ * @notes Reduces by Lemire's multiply-shift, as LemireUniformIntDist. Unbiased:
+ *   products whose low word falls below 2^64 % (high - low + 1) are rejected
+ *   and redrawn from further counter blocks, deterministically per position.
+ */
+template<typename IntT,
+         typename = std::enable_if_t<std::is_integral_v<IntT>>>
+class CounterUniformRandIntGen :
+        public CounterUniformRandNumGen<CounterUniformRandIntGen<IntT>, IntT> {
+    friend class CounterUniformRandNumGen<CounterUniformRandIntGen<IntT>, IntT>;
+    static_assert(sizeof(IntT) <= sizeof(std::uint64_t),
+                  "CounterUniformRandIntGen supports up to 64-bit integers");
+    using UIntT = std::make_unsigned_t<IntT>;
+public:
+    CounterUniformRandIntGen(IntT low, IntT high, std::uint64_t seed_val) :
+        CounterUniformRandNumGen<CounterUniformRandIntGen<IntT>, IntT>(seed_val),
+        low{ low },
+        // wraps to 0 for the full 64-bit range
+        range{ std::uint64_t{ static_cast<UIntT>(
+                    static_cast<UIntT>(high) - static_cast<UIntT>(low)) } + 1 },
+        threshold{ range == 0 ? 0 : (0 - range) % range } {}
+
+private:
+    IntT fromBits(const std::uint64_t index, const std::uint32_t hi,
+                  const std::uint32_t lo) const {
+        std::uint64_t bits { (std::uint64_t{ hi } << 32) | lo };
+        if (range == 0)
+            return static_cast<IntT>(bits);
+        // Lemire multiply-shift reduction
+        impl::U64Product prod { impl::mul64x64(bits, range) };
+        for (std::uint32_t attempt { 1 }; prod.lo < threshold; ++attempt)
+            prod = impl::mul64x64(this->redrawBits(index, attempt), range);
+        return static_cast<IntT>(static_cast<UIntT>(low) +
+                                 static_cast<UIntT>(prod.hi));
+    }
+
+    IntT low;
+    std::uint64_t range;      // high - low + 1, mod 2^64
+    std::uint64_t threshold;  // 2^64 % range
+};
+
+/*
+ * @notes Values in [low, high) are made from each position's 64 bits as by
+ *   MantissaUniformRealDist::fromBits(), with the same range guarantees.
+ */
+template<typename RealT,
+         typename = std::enable_if_t<std::is_floating_point_v<RealT>>>
+class CounterUniformRandRealGen :
+        public CounterUniformRandNumGen<CounterUniformRandRealGen<RealT>, RealT> {
+    friend class CounterUniformRandNumGen<CounterUniformRandRealGen<RealT>, RealT>;
+public:
+    CounterUniformRandRealGen(RealT low, RealT high, std::uint64_t seed_val) :
+        CounterUniformRandNumGen<CounterUniformRandRealGen<RealT>, RealT>(seed_val),
+        dist{ low, high } {}
+
+private:
+    RealT fromBits(std::uint64_t, const std::uint32_t hi,
+                   const std::uint32_t lo) const {
+        return dist.fromBits((std::uint64_t{ hi } << 32) | lo);
+    }
+
+    MantissaUniformRealDist<RealT> dist;
+};
+
+
+#endif  // COUNTERUNIFORMRANDNUMGEN_HH
@@ -0,0 +1,261 @@
+#ifndef LEMIREUNIFORMINTDIST_HH
+#define LEMIREUNIFORMINTDIST_HH
+
+
+#if __cplusplus < 201703L
+#error "C++17 and above required due to use of variable templates \
+std::is_integral_v and if constexpr"
+#endif
+
+#include <cstdint>      // uint32_t, uint64_t
+#include <limits>       // numeric_limits
+#include <random>       // uniform_int_distribution
+#include <type_traits>  // enable_if_t, make_unsigned_t
+
+/*
+ * Unbiased bounded integers by multiply-shift, adapted from:
+ *   - Lemire, "Fast Random Integer Generation in an Interval" (2019),
+ *     https://arxiv.org/abs/1805.10941
+ *   - Brackett-Rozinsky and Lemire, "Batched Ranged Random Integer Generation"
+ *     (2024), https://arxiv.org/abs/2408.06213
+ */
+
+namespace impl {
+
+struct U64Product {
+    std::uint64_t hi;
+    std::uint64_t lo;
+};
+
+/*
+ * @brief Full 128-bit product of two 64-bit words.
+ */
+constexpr U64Product mul64x64(const std::uint64_t a, const std::uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    __extension__ using uint128_t = unsigned __int128;
+    const uint128_t prod { static_cast<uint128_t>(a) * b };
+    return { static_cast<std::uint64_t>(prod >> 64),
+             static_cast<std::uint64_t>(prod) };
+#else
+    const std::uint64_t a_lo { a & 0xffffffff }, a_hi { a >> 32 };
+    const std::uint64_t b_lo { b & 0xffffffff }, b_hi { b >> 32 };
+    const std::uint64_t lo_lo { a_lo * b_lo };
+    const std::uint64_t hi_lo { a_hi * b_lo };
+    const std::uint64_t lo_hi { a_lo * b_hi };
+    const std::uint64_t cross { (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi };
+    return { a_hi * b_hi + (hi_lo >> 32) + (cross >> 32),
+             (cross << 32) | (lo_lo & 0xffffffff) };
+#endif
+}
+
+/*
+ * @brief Whether an engine's outputs are full 32- or 64-bit words, as the
+ *   multiply-shift and mantissa paths need; others, eg std::minstd_rand or
+ *   std::ranlux24, go through the standard distributions.
+ */
+template<typename URBG>
+constexpr bool is_full_word_engine_v = URBG::min() == 0 &&
+    (URBG::max() == std::numeric_limits<std::uint32_t>::max() ||
+     URBG::max() == std::numeric_limits<std::uint64_t>::max());
+
+/*
+ * @brief Next 32 uniform bits from an engine of 32- or 64-bit words.
+ */
+template<typename URBG>
+std::uint32_t draw32(URBG& g) {
+    static_assert(URBG::min() == 0, "engine must output full-width words");
+    if constexpr (URBG::max() == std::numeric_limits<std::uint32_t>::max()) {
+        return static_cast<std::uint32_t>(g());
+    } else {
+        static_assert(URBG::max() == std::numeric_limits<std::uint64_t>::max(),
+                      "engine must output 32- or 64-bit words");
+        return static_cast<std::uint32_t>(g() >> 32);
+    }
+}
+
+/*
+ * @brief Next 64 uniform bits from an engine of 32- or 64-bit words.
+ */
+template<typename URBG>
+std::uint64_t draw64(URBG& g) {
+    static_assert(URBG::min() == 0, "engine must output full-width words");
+    if constexpr (URBG::max() == std::numeric_limits<std::uint32_t>::max()) {
+        const std::uint64_t hi { g() };
+        return (hi << 32) | static_cast<std::uint32_t>(g());
+    } else {
+        static_assert(URBG::max() == std::numeric_limits<std::uint64_t>::max(),
+                      "engine must output 32- or 64-bit words");
+        return g();
+    }
+}
+
+}  // namespace impl
+
+/*
+ * @brief Drop-in alternative to std::uniform_int_distribution for [low, high]
+ *   using Lemire's multiply-shift reduction, with no division per draw.
+ *
+ * @notes The rejection thresholds that keep the reduction unbiased, which
+ *   Lemire computes lazily with one division, are precomputed at construction
+ *   (or compile time, see FixedLemireUniformIntDist), leaving a multiply and a
+ *   compare per draw. Draws use 64-bit engine words, except for ranges of up
+ *   to 2^32 values drawn from 32-bit engines.
+ *   generate() batches draws: `batchSize()` values are taken from each 64-bit
+ *   engine word by chained multiplication, with a single rejection test
+ *   against the product of their ranges.
+ *   Engines whose outputs are not full 32- or 64-bit words are drawn from
+ *   by std::uniform_int_distribution instead.
+ */
+template<typename IntT,
+         typename = std::enable_if_t<std::is_integral_v<IntT>>>
+class LemireUniformIntDist {
+    static_assert(sizeof(IntT) <= sizeof(std::uint64_t),
+                  "LemireUniformIntDist supports up to 64-bit integers");
+    using UIntT = std::make_unsigned_t<IntT>;
+    static constexpr std::uint64_t max_batch_sz { 16 };
+public:
+    using result_type = IntT;
+
+    constexpr LemireUniformIntDist(IntT low, IntT high) :
+        low{ low }, high{ high },
+        // wraps to 0 for the full 64-bit range
+        range{ std::uint64_t{ static_cast<UIntT>(
+                    static_cast<UIntT>(high) - static_cast<UIntT>(low)) } + 1 },
+        threshold32{ 0 }, threshold64{ 0 }, batch_sz{ 1 },
+        batch_range{ range }, batch_threshold{ 0 } {
+        if (range == 0)
+            return;
+        if (range <= (std::uint64_t{ 1 } << 32))
+            threshold32 = ((std::uint64_t{ 1 } << 32) - range) % range;
+        threshold64 = (0 - range) % range;
+        while (batch_sz < max_batch_sz &&
+               batch_range <= std::numeric_limits<std::uint64_t>::max() / range) {
+            batch_range *= range;
+            ++batch_sz;
+        }
+        batch_threshold = (0 - batch_range) % batch_range;
+    }
+
+    template<typename URBG>
+    IntT operator()(URBG& g) const {
+        if constexpr (!impl::is_full_word_engine_v<URBG>) {
+            return std::uniform_int_distribution<IntT>{ low, high }(g);
+        } else {
+            if (range == 0)
+                return static_cast<IntT>(impl::draw64(g));
+            // 32-bit words only for 32-bit engines, as otherwise half of each
+            //   draw would be wasted and rejection made more likely
+            if (URBG::max() == std::numeric_limits<std::uint32_t>::max() &&
+                range <= (std::uint64_t{ 1 } << 32)) {
+                std::uint64_t prod { std::uint64_t{ impl::draw32(g) } * range };
+                while (static_cast<std::uint32_t>(prod) < threshold32)
+                    prod = std::uint64_t{ impl::draw32(g) } * range;
+                return offset(prod >> 32);
+            }
+            impl::U64Product prod { impl::mul64x64(impl::draw64(g), range) };
+            while (prod.lo < threshold64)
+                prod = impl::mul64x64(impl::draw64(g), range);
+            return offset(prod.hi);
+        }
+    }
+
+    /*
+     * @brief Fills [first, last) with independent draws, batchSize() per
+     *   64-bit engine word.
+     */
+    template<typename URBG, typename OutputIt>
+    void generate(URBG& g, OutputIt first, OutputIt last) const {
+        if constexpr (impl::is_full_word_engine_v<URBG>) {
+            if (batch_sz > 1) {
+                UIntT batch[max_batch_sz];
+                // any surplus from the final batch is discarded
+                while (first != last) {
+                    drawBatch(g, batch);
+                    for (std::uint64_t i { 0 }; i < batch_sz && first != last;
+                         ++i, ++first)
+                        *first = offset(batch[i]);
+                }
+                return;
+            }
+        }
+        for (; first != last; ++first)
+            *first = (*this)(g);
+    }
+
+    constexpr IntT a() const { return low; }
+    constexpr IntT b() const { return high; }
+    constexpr IntT min() const { return low; }
+    constexpr IntT max() const { return high; }
+    constexpr std::uint64_t batchSize() const { return batch_sz; }
+
+    friend constexpr bool operator==(const LemireUniformIntDist& lhs,
+                                     const LemireUniformIntDist& rhs) {
+        return lhs.low == rhs.low && lhs.high == rhs.high;
+    }
+    friend constexpr bool operator!=(const LemireUniformIntDist& lhs,
+                                     const LemireUniformIntDist& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    constexpr IntT offset(const std::uint64_t reduced) const {
+        return static_cast<IntT>(static_cast<UIntT>(low) +
+                                 static_cast<UIntT>(reduced));
+    }
+
+    /*
+     * @brief Chained multiply-shift: after multiplying by each range in turn,
+     *   the low word is x * batch_range mod 2^64, so one comparison with
+     *   2^64 % batch_range decides acceptance of the whole batch.
+     */
+    template<typename URBG>
+    void drawBatch(URBG& g, UIntT* out) const {
+        for (;;) {
+            impl::U64Product prod { impl::mul64x64(impl::draw64(g), range) };
+            out[0] = static_cast<UIntT>(prod.hi);
+            for (std::uint64_t i { 1 }; i < batch_sz; ++i) {
+                prod = impl::mul64x64(prod.lo, range);
+                out[i] = static_cast<UIntT>(prod.hi);
+            }
+            if (prod.lo >= batch_threshold)
+                return;
+        }
+    }
+
+    IntT low;
+    IntT high;
+    std::uint64_t range;            // high - low + 1, mod 2^64
+    std::uint64_t threshold32;      // 2^32 % range, if range <= 2^32
+    std::uint64_t threshold64;      // 2^64 % range
+    std::uint64_t batch_sz;         // draws per 64-bit word in generate()
+    std::uint64_t batch_range;      // range^batch_sz
+    std::uint64_t batch_threshold;  // 2^64 % batch_range
+};
+
+/*
+ * @brief LemireUniformIntDist with bounds fixed at compile time, so that its
+ *   range and thresholds fold into the instruction stream as constants.
+ */
+template<typename IntT, IntT Low, IntT High>
+class FixedLemireUniformIntDist {
+public:
+    using result_type = IntT;
+
+    template<typename URBG>
+    IntT operator()(URBG& g) const { return dist(g); }
+
+    template<typename URBG, typename OutputIt>
+    void generate(URBG& g, OutputIt first, OutputIt last) const {
+        dist.generate(g, first, last);
+    }
+
+    static constexpr IntT min() { return Low; }
+    static constexpr IntT max() { return High; }
+    static constexpr std::uint64_t batchSize() { return dist.batchSize(); }
+
+private:
+    static constexpr LemireUniformIntDist<IntT> dist { Low, High };
+};
+
+
+#endif  // LEMIREUNIFORMINTDIST_HH
@@ -0,0 +1,255 @@
+#ifndef MANTISSAUNIFORMREALDIST_HH
+#define MANTISSAUNIFORMREALDIST_HH
+
+
+#if __cplusplus < 201703L
+#error "C++17 and above required due to use of variable templates \
+std::is_same_v and if constexpr"
+#endif
+
+#include "LemireUniformIntDist.hh"  // impl::draw32, impl::draw64
+
+#include <algorithm>    // copy_n, max, min
+#include <cmath>        // nextafter
+#include <cstddef>      // size_t
+#include <cstdint>      // uint32_t, uint64_t
+#include <cstring>      // memcpy
+#include <iterator>     // distance, forward_iterator_tag, iterator_traits
+#include <limits>       // numeric_limits
+#include <random>       // uniform_real_distribution
+#include <type_traits>  // conditional_t, enable_if_t, false_type, true_type, void_t
+#include <utility>      // declval
+
+/*
+ * Uniform reals from raw engine bits by the mantissa bit trick: random bits
+ *   below the exponent of 1.0 make a value in [1, 2), without any division or
+ *   integer-to-float conversion, as in:
+ *   - https://prng.di.unimi.it/ ("Generating uniform doubles in the unit
+ *     interval")
+ */
+
+namespace impl {
+
+template<typename RealT>
+struct MantissaLayout;
+
+template<>
+struct MantissaLayout<double> {
+    using word_type = std::uint64_t;
+    static constexpr int mantissa_bits { 52 };
+    static constexpr word_type one_bits { 0x3ff0000000000000 };  // 1.0
+};
+
+template<>
+struct MantissaLayout<float> {
+    using word_type = std::uint32_t;
+    static constexpr int mantissa_bits { 23 };
+    static constexpr word_type one_bits { 0x3f800000 };  // 1.0f
+};
+
+template<typename RealT>
+constexpr bool has_mantissa_layout_v =
+    std::is_same_v<RealT, float> || std::is_same_v<RealT, double>;
+
+/*
+ * @brief Value in [1, 2) taking the top mantissa_bits of `word` as mantissa.
+ */
+template<typename RealT>
+inline RealT oneToTwo(const typename MantissaLayout<RealT>::word_type word) {
+    using Layout = MantissaLayout<RealT>;
+    const typename Layout::word_type bits {
+        static_cast<typename Layout::word_type>(
+            word >> (sizeof(word) * 8 - Layout::mantissa_bits)) |
+        Layout::one_bits };
+    RealT val;
+    std::memcpy(&val, &bits, sizeof(val));
+    return val;
+}
+
+/*
+ * @brief Uniform double in [0, 1) from the top 52 bits of one 64-bit word.
+ */
+template<typename URBG>
+double unitClosedOpen(URBG& g) {
+    return oneToTwo<double>(draw64(g)) - 1;
+}
+
+/*
+ * @brief Uniform double in (0, 1], eg for taking logarithms.
+ */
+template<typename URBG>
+double unitOpenClosed(URBG& g) {
+    return 2 - oneToTwo<double>(draw64(g));
+}
+
+template<typename EngineT, typename = void>
+struct has_fill : std::false_type {};
+
+template<typename EngineT>
+struct has_fill<EngineT, std::void_t<decltype(std::declval<EngineT&>().fill(
+        std::declval<std::uint64_t*>(), std::size_t{}))>> : std::true_type {};
+
+/*
+ * @brief Next `count` 64-bit words from an engine, through its own bulk fill()
+ *   where it has one (such as Xoshiro256ppX4).
+ */
+template<typename URBG>
+void fillWords64(URBG& g, std::uint64_t* out, const std::size_t count) {
+    if constexpr (has_fill<URBG>::value &&
+                  std::is_same_v<typename URBG::result_type, std::uint64_t>) {
+        g.fill(out, count);
+    } else {
+        for (std::size_t i { 0 }; i < count; ++i)
+            out[i] = draw64(g);
+    }
+}
+
+}  // namespace impl
+
+/*
+ * @brief Drop-in alternative to std::uniform_real_distribution for [low, high)
+ *   that builds each value directly from engine bits, with no division and
+ *   no more engine words than one value needs.
+ *
+ * @notes Each draw makes u + 1 in [1, 2) from the top 52 (double) or 23 (float)
+ *   bits of one 64-bit (double) or 32-bit (float) engine word, then scales it
+ *   with a single multiply-add, (u + 1) * (high - low) + (low - (high - low)).
+ *   Guarantees, for finite low < high:
+ *   - results lie in [low, high): rounding towards `high` is clamped to the
+ *     largest value below it, and rounding below `low` is clamped to `low`;
+ *   - u is one of 2^52 (double) or 2^23 (float) equally spaced values in
+ *     [0, 1), each equally likely, so it can never round up to 1 as
+ *     std::generate_canonical can; the cost is that values of u finer than
+ *     2^-52 (2^-23) are never produced.
+ *   low == high yields `low`, as std::uniform_real_distribution does.
+ *   generate() converts blocks of engine words in a loop the compiler can
+ *   vectorize, where the engine has a bulk fill() (such as Xoshiro256ppX4) or
+ *   for float from 64-bit engines. In the latter case it takes two values per
+ *   word (high half first), where operator() uses only the high half, so the
+ *   bulk and single-draw sequences then differ.
+ *   Other floating point types (eg long double), and engines whose outputs
+ *   are not full 32- or 64-bit words, are drawn from by
+ *   std::uniform_real_distribution instead, clamped below `high` likewise.
+ */
+template<typename RealT,
+         typename = std::enable_if_t<std::is_floating_point_v<RealT>>>
+class MantissaUniformRealDist {
+    using WordT = typename impl::MantissaLayout<std::conditional_t<
+        impl::has_mantissa_layout_v<RealT>, RealT, double>>::word_type;
+    static constexpr std::size_t block_sz { 256 };  // values per generate() pass
+public:
+    using result_type = RealT;
+
+    MantissaUniformRealDist(RealT low, RealT high) :
+        low{ low }, high{ high }, span{ high - low }, offset{ low - span },
+        below_high{ low < high ? std::nextafter(high, low) : low } {}
+
+    template<typename URBG>
+    RealT operator()(URBG& g) const {
+        if constexpr (!impl::has_mantissa_layout_v<RealT> ||
+                      !impl::is_full_word_engine_v<URBG>)
+            return std::min(std::uniform_real_distribution<RealT>{ low, high }(g),
+                            below_high);
+        else if constexpr (std::is_same_v<RealT, float>)
+            return scale(impl::oneToTwo<float>(impl::draw32(g)));
+        else
+            return scale(impl::oneToTwo<double>(impl::draw64(g)));
+    }
+
+    /*
+     * @brief Maps 64 uniform bits to a value in [low, high), using the top 32
+     *   bits for float; eg for counter-based engines.
+     */
+    RealT fromBits(const std::uint64_t bits) const {
+        if constexpr (impl::has_mantissa_layout_v<RealT>) {
+            return scale(impl::oneToTwo<RealT>(static_cast<WordT>(
+                bits >> (64 - sizeof(WordT) * 8))));
+        } else {
+            // top 53 bits, as for double
+            const RealT u { static_cast<RealT>(bits >> 11) * RealT { 0x1p-53 } };
+            return std::min(low + u * span, below_high);
+        }
+    }
+
+    /*
+     * @brief Fills [first, last) with independent draws, a block at a time.
+     */
+    template<typename URBG, typename OutputIt>
+    void generate(URBG& g, OutputIt first, OutputIt last) const {
+        using CategoryT = typename std::iterator_traits<OutputIt>::iterator_category;
+        // blocks pay off for engines with a bulk fill() or when a 64-bit word
+        //   yields two floats; otherwise a fused per-value loop is faster, and
+        //   single-pass output leaves the length unknown in advance
+        constexpr bool use_blocks {
+            impl::has_mantissa_layout_v<RealT> &&
+            impl::is_full_word_engine_v<URBG> &&
+            (impl::has_fill<URBG>::value ||
+             (std::is_same_v<RealT, float> &&
+              URBG::max() == std::numeric_limits<std::uint64_t>::max())) &&
+            std::is_base_of_v<std::forward_iterator_tag, CategoryT> };
+        if constexpr (!use_blocks) {
+            for (; first != last; ++first)
+                *first = (*this)(g);
+        } else {
+            constexpr std::size_t vals_per_word { sizeof(std::uint64_t) /
+                                                  sizeof(WordT) };
+            std::uint64_t words[block_sz / vals_per_word];
+            RealT vals[block_sz];
+            for (auto remaining { std::distance(first, last) }; remaining > 0;) {
+                const std::size_t val_ct { std::min<std::size_t>(
+                        block_sz, static_cast<std::size_t>(remaining)) };
+                // any surplus value from an odd final float block is discarded
+                const std::size_t word_ct {
+                    (val_ct + vals_per_word - 1) / vals_per_word };
+                impl::fillWords64(g, words, word_ct);
+                convertBlock(words, word_ct, vals);
+                first = std::copy_n(vals, val_ct, first);
+                remaining -= static_cast<decltype(remaining)>(val_ct);
+            }
+        }
+    }
+
+    RealT a() const { return low; }
+    RealT b() const { return high; }
+    RealT min() const { return low; }
+    RealT max() const { return high; }
+
+    friend bool operator==(const MantissaUniformRealDist& lhs,
+                           const MantissaUniformRealDist& rhs) {
+        return lhs.low == rhs.low && lhs.high == rhs.high;
+    }
+    friend bool operator!=(const MantissaUniformRealDist& lhs,
+                           const MantissaUniformRealDist& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    RealT scale(const RealT one_to_two) const {
+        // min/max rather than branches, to keep block conversion vectorizable
+        return std::min(std::max(one_to_two * span + offset, low), below_high);
+    }
+
+    void convertBlock(const std::uint64_t* words, const std::size_t word_ct,
+                      RealT* out) const {
+        if constexpr (std::is_same_v<RealT, float>) {
+            for (std::size_t i { 0 }; i < word_ct; ++i) {
+                out[2 * i] = scale(impl::oneToTwo<float>(
+                        static_cast<std::uint32_t>(words[i] >> 32)));
+                out[2 * i + 1] = scale(impl::oneToTwo<float>(
+                        static_cast<std::uint32_t>(words[i])));
+            }
+        } else {
+            for (std::size_t i { 0 }; i < word_ct; ++i)
+                out[i] = scale(impl::oneToTwo<double>(words[i]));
+        }
+    }
+
+    RealT low;
+    RealT high;
+    RealT span;        // high - low
+    RealT offset;      // low - span, as low + u * span == (u + 1) * span + offset
+    RealT below_high;  // largest value below high, or low if low == high
+};
+
+
+#endif  // MANTISSAUNIFORMREALDIST_HH
@@ -0,0 +1,146 @@
+#ifndef NONUNIFORMRANDNUMGEN_HH
+#define NONUNIFORMRANDNUMGEN_HH
+
+
+#if __cplusplus < 201703L
+#error "C++17 and above required due to use of variable templates \
+std::is_integral_v and std::is_floating_point_v"
+#endif
+
+#include "PoissonDist.hh"
+#include "UniformRandNumGen.hh"
+#include "ZigguratDist.hh"
+
+#include <cstdint>     // uint64_t
+#include <random>      // mt19937
+#include <type_traits>
+
+/*
+ * Normal, exponential and Poisson generators in both families of
+ *   UniformRandNumGen.hh, drawing through ZigguratNormalDist,
+ *   ZigguratExponentialDist and PoissonDist in place of the std distributions.
+ */
+
+template<typename RealT, typename EngineT = std::mt19937,
+         typename = std::enable_if_t<std::is_floating_point_v<RealT>>>
+class NormalRandGen : public UniformRandNumGen<RealT, EngineT> {
+public:
+    NormalRandGen(RealT mean, RealT stddev) :dist{mean, stddev} {}
+    NormalRandGen(RealT mean, RealT stddev, std::uint64_t seed_val) :
+        UniformRandNumGen<RealT, EngineT>(seed_val), dist{mean, stddev} {}
+    NormalRandGen(RealT mean, RealT stddev, const EngineT& engine) :
+        UniformRandNumGen<RealT, EngineT>(engine), dist{mean, stddev} {}
+    RealT operator()() { return dist(this->rng); }
+private:
+    ZigguratNormalDist<RealT> dist;
+};
+
+template<typename RealT, typename EngineT = std::mt19937,
+         typename = std::enable_if_t<std::is_floating_point_v<RealT>>>
+class ExponentialRandGen : public UniformRandNumGen<RealT, EngineT> {
+public:
+    explicit ExponentialRandGen(RealT lambda) :dist{lambda} {}
+    ExponentialRandGen(RealT lambda, std::uint64_t seed_val) :
+        UniformRandNumGen<RealT, EngineT>(seed_val), dist{lambda} {}
+    ExponentialRandGen(RealT lambda, const EngineT& engine) :
+        UniformRandNumGen<RealT, EngineT>(engine), dist{lambda} {}
+    RealT operator()() { return dist(this->rng); }
+private:
+    ZigguratExponentialDist<RealT> dist;
+};
+
+template<typename IntT, typename EngineT = std::mt19937,
+         typename = std::enable_if_t<std::is_integral_v<IntT>>>
+class PoissonRandGen : public UniformRandNumGen<IntT, EngineT> {
+public:
+    explicit PoissonRandGen(double mean) :dist{mean} {}
+    PoissonRandGen(double mean, std::uint64_t seed_val) :
+        UniformRandNumGen<IntT, EngineT>(seed_val), dist{mean} {}
+    PoissonRandGen(double mean, const EngineT& engine) :
+        UniformRandNumGen<IntT, EngineT>(engine), dist{mean} {}
+    IntT operator()() { return dist(this->rng); }
+private:
+    PoissonDist<IntT> dist;
+};
+
+template<typename RealT, typename EngineT = std::mt19937,
+         typename = std::enable_if_t<std::is_floating_point_v<RealT>>>
+class StaticNormalRandGen :
+        public StaticUniformRandNumGen<StaticNormalRandGen<RealT, EngineT>,
+                                       RealT, EngineT> {
+    friend class StaticUniformRandNumGen<StaticNormalRandGen<RealT, EngineT>,
+                                         RealT, EngineT>;
+public:
+    StaticNormalRandGen(RealT mean, RealT stddev) :dist{mean, stddev} {}
+    StaticNormalRandGen(RealT mean, RealT stddev, std::uint64_t seed_val) :
+        StaticUniformRandNumGen<StaticNormalRandGen<RealT, EngineT>,
+                                RealT, EngineT>(seed_val),
+        dist{mean, stddev} {}
+    StaticNormalRandGen(RealT mean, RealT stddev, const EngineT& engine) :
+        StaticUniformRandNumGen<StaticNormalRandGen<RealT, EngineT>,
+                                RealT, EngineT>(engine),
+        dist{mean, stddev} {}
+private:
+    RealT draw() { return dist(this->rng); }
+
+    template<typename OutputIt>
+    void drawBulk(OutputIt first, OutputIt last) {
+        dist.generate(this->rng, first, last);
+    }
+
+    ZigguratNormalDist<RealT> dist;
+};
+
+template<typename RealT, typename EngineT = std::mt19937,
+         typename = std::enable_if_t<std::is_floating_point_v<RealT>>>
+class StaticExponentialRandGen :
+        public StaticUniformRandNumGen<StaticExponentialRandGen<RealT, EngineT>,
+                                       RealT, EngineT> {
+    friend class StaticUniformRandNumGen<StaticExponentialRandGen<RealT, EngineT>,
+                                         RealT, EngineT>;
+public:
+    explicit StaticExponentialRandGen(RealT lambda) :dist{lambda} {}
+    StaticExponentialRandGen(RealT lambda, std::uint64_t seed_val) :
+        StaticUniformRandNumGen<StaticExponentialRandGen<RealT, EngineT>,
+                                RealT, EngineT>(seed_val),
+        dist{lambda} {}
+    StaticExponentialRandGen(RealT lambda, const EngineT& engine) :
+        StaticUniformRandNumGen<StaticExponentialRandGen<RealT, EngineT>,
+                                RealT, EngineT>(engine),
+        dist{lambda} {}
+private:
+    RealT draw() { return dist(this->rng); }
+
+    template<typename OutputIt>
+    void drawBulk(OutputIt first, OutputIt last) {
+        dist.generate(this->rng, first, last);
+    }
+
+    ZigguratExponentialDist<RealT> dist;
+};
+
+template<typename IntT, typename EngineT = std::mt19937,
+         typename = std::enable_if_t<std::is_integral_v<IntT>>>
+class StaticPoissonRandGen :
+        public StaticUniformRandNumGen<StaticPoissonRandGen<IntT, EngineT>,
+                                       IntT, EngineT> {
+    friend class StaticUniformRandNumGen<StaticPoissonRandGen<IntT, EngineT>,
+                                         IntT, EngineT>;
+public:
+    explicit StaticPoissonRandGen(double mean) :dist{mean} {}
+    StaticPoissonRandGen(double mean, std::uint64_t seed_val) :
+        StaticUniformRandNumGen<StaticPoissonRandGen<IntT, EngineT>,
+                                IntT, EngineT>(seed_val),
+        dist{mean} {}
+    StaticPoissonRandGen(double mean, const EngineT& engine) :
+        StaticUniformRandNumGen<StaticPoissonRandGen<IntT, EngineT>,
+                                IntT, EngineT>(engine),
+        dist{mean} {}
+private:
+    IntT draw() { return dist(this->rng); }
+
+    PoissonDist<IntT> dist;
+};
+
+
+#endif  // NONUNIFORMRANDNUMGEN_HH
@@ -0,0 +1,91 @@
+#ifndef PCG32_HH
+#define PCG32_HH
+
+
+#include <cstdint>      // uint32_t, uint64_t
+#include <limits>       // numeric_limits
+
+/*
+ * PCG32 (XSH RR 64/32) by Melissa O'Neill, adapted from the Apache 2.0
+ *   licensed minimal C implementation:
+ *   - https://www.pcg-random.org/download.html
+ */
+
+/*
+ * @brief PCG32 engine, satisfying UniformRandomBitGenerator.
+ *
+ * @notes 16 bytes of state: a 64-bit LCG state and an odd increment selecting
+ *   one of 2^63 streams, each with period 2^64. discard() is O(log n) by LCG
+ *   jump-ahead.
+ */
+class Pcg32 {
+    static constexpr std::uint64_t multiplier { 6364136223846793005 };
+public:
+    using result_type = std::uint32_t;
+
+    static constexpr std::uint64_t default_stream { 0xda3e39cb94b95bdb };
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    constexpr Pcg32() :Pcg32(0) {}
+    constexpr explicit Pcg32(std::uint64_t seed_val,
+                             std::uint64_t stream = default_stream) :
+        state{ 0 }, inc{ 0 } {
+        seed(seed_val, stream);
+    }
+
+    constexpr void seed(std::uint64_t seed_val,
+                        std::uint64_t stream = default_stream) {
+        state = 0;
+        inc = (stream << 1) | 1;
+        step();
+        state += seed_val;
+        step();
+    }
+
+    constexpr result_type operator()() {
+        const std::uint64_t old_state { state };
+        step();
+        const std::uint32_t xorshifted {
+            static_cast<std::uint32_t>(((old_state >> 18) ^ old_state) >> 27) };
+        const std::uint32_t rot { static_cast<std::uint32_t>(old_state >> 59) };
+        return (xorshifted >> rot) | (xorshifted << ((0 - rot) & 31));
+    }
+
+    /*
+     * @brief Advances by `z` draws in O(log z), per Brown, "Random Number
+     *   Generation with Arbitrary Stride" (1994).
+     */
+    constexpr void discard(unsigned long long z) {
+        std::uint64_t acc_mult { 1 }, acc_plus { 0 };
+        std::uint64_t cur_mult { multiplier }, cur_plus { inc };
+        for (; z != 0; z >>= 1) {
+            if (z & 1) {
+                acc_mult *= cur_mult;
+                acc_plus = acc_plus * cur_mult + cur_plus;
+            }
+            cur_plus = (cur_mult + 1) * cur_plus;
+            cur_mult *= cur_mult;
+        }
+        state = acc_mult * state + acc_plus;
+    }
+
+    friend constexpr bool operator==(const Pcg32& lhs, const Pcg32& rhs) {
+        return lhs.state == rhs.state && lhs.inc == rhs.inc;
+    }
+    friend constexpr bool operator!=(const Pcg32& lhs, const Pcg32& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    constexpr void step() { state = state * multiplier + inc; }
+
+    std::uint64_t state;
+    std::uint64_t inc;    // always odd
+};
+
+
+#endif  // PCG32_HH
@@ -0,0 +1,126 @@
+#ifndef PHILOX4X32_HH
+#define PHILOX4X32_HH
+
+
+#if __cplusplus < 201703L
+#error "C++17 and above required due to use of constexpr std::array access"
+#endif
+
+#include <array>
+#include <cstddef>      // size_t
+#include <cstdint>      // uint32_t, uint64_t
+#include <limits>       // numeric_limits
+
+/*
+ * Philox4x32-10 counter-based generator, from:
+ *   - Salmon et al, "Parallel Random Numbers: As Easy as 1, 2, 3" (SC11)
+ *   - https://github.com/DEShawResearch/random123
+ */
+
+namespace impl {
+
+constexpr std::uint32_t philox_m0 { 0xD2511F53 };
+constexpr std::uint32_t philox_m1 { 0xCD9E8D57 };
+constexpr std::uint32_t philox_w0 { 0x9E3779B9 };  // golden ratio
+constexpr std::uint32_t philox_w1 { 0xBB67AE85 };  // sqrt(3) - 1
+
+}  // namespace impl
+
+/*
+ * @brief Philox4x32-10: each 128-bit output block is a pure function of a
+ *   64-bit key and a 128-bit counter, so any position in the sequence can be
+ *   computed in O(1) and with no carried state beyond (key, counter).
+ *
+ * @notes Also usable as a sequential UniformRandomBitGenerator, yielding the
+ *   four words of block 0, then of block 1, and so on; discard() is O(1).
+ */
+class Philox4x32 {
+public:
+    using result_type = std::uint32_t;
+    using counter_type = std::array<std::uint32_t, 4>;
+    using key_type = std::array<std::uint32_t, 2>;
+
+    static constexpr std::size_t words_per_block { 4 };
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /*
+     * @brief Computes the output block for `ctr` under `key`.
+     */
+    static constexpr counter_type block(key_type key, counter_type ctr) {
+        for (int round { 0 }; round < 10; ++round) {
+            if (round != 0) {
+                key[0] += impl::philox_w0;
+                key[1] += impl::philox_w1;
+            }
+            const std::uint64_t prod0 {
+                std::uint64_t{ impl::philox_m0 } * ctr[0] };
+            const std::uint64_t prod1 {
+                std::uint64_t{ impl::philox_m1 } * ctr[2] };
+            ctr = {
+                static_cast<std::uint32_t>(prod1 >> 32) ^ ctr[1] ^ key[0],
+                static_cast<std::uint32_t>(prod1),
+                static_cast<std::uint32_t>(prod0 >> 32) ^ ctr[3] ^ key[1],
+                static_cast<std::uint32_t>(prod0)
+            };
+        }
+        return ctr;
+    }
+
+    /*
+     * @brief Computes block number `index` (counter {index, 0}) under `key`.
+     */
+    static constexpr counter_type block(const key_type& key,
+                                        const std::uint64_t index) {
+        return block(key, counter_type{ static_cast<std::uint32_t>(index),
+                                        static_cast<std::uint32_t>(index >> 32),
+                                        0, 0 });
+    }
+
+    static constexpr key_type keyFromSeed(const std::uint64_t seed_val) {
+        return key_type{ static_cast<std::uint32_t>(seed_val),
+                         static_cast<std::uint32_t>(seed_val >> 32) };
+    }
+
+    constexpr Philox4x32() :Philox4x32(0) {}
+    constexpr explicit Philox4x32(std::uint64_t seed_val) :
+        key{ keyFromSeed(seed_val) }, buf{}, pos{ 0 } {}
+
+    constexpr void seed(std::uint64_t seed_val) {
+        key = keyFromSeed(seed_val);
+        pos = 0;
+    }
+
+    constexpr result_type operator()() {
+        const std::size_t word { pos % words_per_block };
+        if (word == 0)
+            buf = block(key, pos / words_per_block);
+        ++pos;
+        return buf[word];
+    }
+
+    constexpr void discard(unsigned long long z) { seek(pos + z); }
+
+    /*
+     * @brief Sets the next draw to be word `position` of the sequence.
+     */
+    constexpr void seek(std::uint64_t position) {
+        pos = position;
+        if (pos % words_per_block != 0)
+            buf = block(key, pos / words_per_block);
+    }
+
+    constexpr std::uint64_t position() const { return pos; }
+    constexpr const key_type& getKey() const { return key; }
+
+private:
+    key_type key;
+    counter_type buf;   // block containing word pos - 1, if pos % 4 != 0
+    std::uint64_t pos;  // words drawn so far
+};
+
+
+#endif  // PHILOX4X32_HH
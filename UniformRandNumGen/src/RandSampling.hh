@@ -0,0 +1,391 @@
+#ifndef RANDSAMPLING_HH
+#define RANDSAMPLING_HH
+
+
+#if __cplusplus < 201703L
+#error "C++17 and above required due to use of if constexpr and \
+std::is_base_of_v"
+#endif
+
+#include "LemireUniformIntDist.hh"     // impl::draw64, impl::mul64x64
+#include "MantissaUniformRealDist.hh"  // impl::unitOpenClosed
+#include "RandSeed.hh"                 // impl::seededEngine
+
+#include <algorithm>    // min, move
+#include <cmath>        // exp, floor, log, log1p
+#include <cstddef>      // size_t
+#include <cstdint>      // uint16_t, uint64_t
+#include <initializer_list>
+#include <iterator>     // iterator_traits, random_access_iterator_tag
+#include <memory>       // unique_ptr
+#include <numeric>      // accumulate
+#include <stdexcept>    // invalid_argument
+#include <thread>
+#include <type_traits>  // is_base_of_v
+#include <utility>      // swap
+#include <vector>
+
+/*
+ * Shuffling and sampling without replacement, adapted from:
+ *   - Brackett-Rozinsky and Lemire, "Batched Ranged Random Integer Generation"
+ *     (2024), https://arxiv.org/abs/2408.06213, for drawing several
+ *     Fisher-Yates indices from each engine word
+ *   - Li, "Reservoir-Sampling Algorithms of Time Complexity O(n(1 + log(N/n)))"
+ *     (1994), Algorithm L
+ *   - Vose, "A Linear Algorithm for Generating Random Numbers with a Given
+ *     Distribution" (1991), for alias tables
+ *   - Sanders, "Random Permutations on Distributed, External and Hierarchical
+ *     Memory" (1998), for the bucketed parallel shuffle
+ *   All take a UniformRandomBitGenerator of full 32- or 64-bit words, such as
+ *   the engines in this library.
+ */
+
+namespace impl {
+
+constexpr std::size_t max_index_batch_sz { 6 };
+
+/*
+ * @brief Indices drawn per engine word when the largest range is `bound`, such
+ *   that the product of the decreasing ranges bound, bound - 1, ... fits in
+ *   64 bits.
+ */
+constexpr std::size_t indexBatchSize(const std::uint64_t bound) {
+    if (bound <= (std::uint64_t{ 1 } << 10))
+        return 6;
+    if (bound <= (std::uint64_t{ 1 } << 12))
+        return 5;
+    if (bound <= (std::uint64_t{ 1 } << 16))
+        return 4;
+    if (bound <= (std::uint64_t{ 1 } << 21))
+        return 3;
+    if (bound <= (std::uint64_t{ 1 } << 32))
+        return 2;
+    return 1;
+}
+
+/*
+ * @brief Writes `out[j]` uniform in [0, bound - j) for j < `count`, all from
+ *   one engine word unless rejected.
+ *
+ * @notes As in LemireUniformIntDist::generate(), the low word of the chained
+ *   products decides acceptance of the whole batch. The rejection threshold
+ *   (a division) is computed only when the low word falls below the product of
+ *   the ranges, which is rare for large bounds.
+ */
+template<typename URBG>
+void drawDecreasingIndices(URBG& g, const std::uint64_t bound,
+                           const std::size_t count, std::uint64_t* out) {
+    std::uint64_t product { bound };
+    for (std::size_t j { 1 }; j < count; ++j)
+        product *= bound - j;
+    for (;;) {
+        U64Product prod { mul64x64(draw64(g), bound) };
+        out[0] = prod.hi;
+        for (std::size_t j { 1 }; j < count; ++j) {
+            prod = mul64x64(prod.lo, bound - j);
+            out[j] = prod.hi;
+        }
+        if (prod.lo >= product || prod.lo >= (0 - product) % product)
+            return;
+    }
+}
+
+/*
+ * @brief Calls `func(i)` for each i in [0, task_ct), spread over up to
+ *   `thread_ct` threads (the calling thread included), each taking i, i +
+ *   thread_ct, ...
+ */
+template<typename FuncT>
+void forEachTaskParallel(const std::size_t task_ct, std::size_t thread_ct,
+                         FuncT&& func) {
+    thread_ct = std::min(std::max<std::size_t>(thread_ct, 1), task_ct);
+    const auto run { [&](const std::size_t offset) {
+        for (std::size_t i { offset }; i < task_ct; i += thread_ct)
+            func(i);
+    } };
+    std::vector<std::thread> workers;
+    workers.reserve(thread_ct);
+    for (std::size_t t { 1 }; t < thread_ct; ++t)
+        workers.emplace_back(run, t);
+    run(0);
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+}  // namespace impl
+
+/*
+ * @brief Fisher-Yates shuffle of [first, last), drawing up to six swap
+ *   indices per engine word; an alternative to std::shuffle, which draws one
+ *   std::uniform_int_distribution value (and so a division) per element.
+ */
+template<typename RandomIt, typename URBG>
+void batchedShuffle(RandomIt first, RandomIt last, URBG& g) {
+    using std::swap;
+    std::uint64_t idx[impl::max_index_batch_sz];
+    for (std::uint64_t i { static_cast<std::uint64_t>(last - first) }; i > 1;) {
+        const std::size_t batch_sz {
+            std::min<std::uint64_t>(impl::indexBatchSize(i), i - 1) };
+        impl::drawDecreasingIndices(g, i, batch_sz, idx);
+        for (std::size_t j { 0 }; j < batch_sz; ++j)
+            swap(first[i - 1 - j], first[idx[j]]);
+        i -= batch_sz;
+    }
+}
+
+/*
+ * @brief Moves a uniform random sample of (middle - first) elements of
+ *   [first, last), in random order, to [first, middle), leaving the rest in
+ *   [middle, last); k-of-n sampling in O(k) draws.
+ */
+template<typename RandomIt, typename URBG>
+void partialShuffle(RandomIt first, RandomIt middle, RandomIt last, URBG& g) {
+    using std::swap;
+    const std::uint64_t n { static_cast<std::uint64_t>(last - first) };
+    const std::uint64_t k { static_cast<std::uint64_t>(middle - first) };
+    std::uint64_t idx[impl::max_index_batch_sz];
+    for (std::uint64_t p { 0 }; p < k;) {
+        const std::size_t batch_sz {
+            std::min<std::uint64_t>(impl::indexBatchSize(n - p), k - p) };
+        impl::drawDecreasingIndices(g, n - p, batch_sz, idx);
+        for (std::size_t j { 0 }; j < batch_sz; ++j)
+            swap(first[p + j], first[p + j + idx[j]]);
+        p += batch_sz;
+    }
+}
+
+/*
+ * @brief Writes a uniform random sample of up to `k` elements of the single
+ *   pass [first, last) to out[0, k), returning the number written (less than
+ *   `k` only if the input is shorter).
+ *
+ * @notes Li's Algorithm L: after the reservoir fills, the gap to the next
+ *   element to keep is drawn directly, costing O(k (1 + log(n / k))) draws for
+ *   n inputs rather than one per input. Gaps are skipped in O(1) where
+ *   InputIt is random access.
+ */
+template<typename InputIt, typename RandomIt, typename URBG>
+std::size_t reservoirSample(InputIt first, InputIt last, RandomIt out,
+                            const std::size_t k, URBG& g) {
+    std::size_t filled { 0 };
+    for (; filled < k && first != last; ++first, ++filled)
+        out[filled] = *first;
+    if (filled < k || k == 0)
+        return filled;
+    const double inv_k { 1.0 / static_cast<double>(k) };
+    double w { std::exp(std::log(impl::unitOpenClosed(g)) * inv_k) };
+    for (;;) {
+        const double gap { std::floor(std::log(impl::unitOpenClosed(g)) /
+                                      std::log1p(-w)) };
+        using CategoryT = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                        CategoryT>) {
+            if (!(gap < static_cast<double>(last - first)))
+                return k;
+            first += static_cast<std::ptrdiff_t>(gap);
+        } else {
+            for (double skipped { 0 }; skipped < gap; ++skipped, ++first) {
+                if (first == last)
+                    return k;
+            }
+            if (first == last)
+                return k;
+        }
+        std::uint64_t slot;
+        impl::drawDecreasingIndices(g, k, 1, &slot);
+        out[slot] = *first;
+        ++first;
+        w *= std::exp(std::log(impl::unitOpenClosed(g)) * inv_k);
+    }
+}
+
+/*
+ * @brief Weighted sampling with replacement of indices [0, n) in O(1) per
+ *   draw, by Vose's alias method.
+ *
+ * @notes Construction is O(n). Each draw takes two engine words (bar rare
+ *   rejections): the product of the first with n gives an unbiased column by
+ *   Lemire's method, and the top 53 bits of the second the biased coin
+ *   choosing between the column and its alias, with resolution 2^-53. (The
+ *   low half of the product is not used as the coin, as it is correlated with
+ *   the column chosen and has fewer than 53 random bits for large n.)
+ */
+class AliasTable {
+public:
+    using result_type = std::size_t;
+
+    /*
+     * @brief Builds the table from non-negative weights, not all zero;
+     *   otherwise throws std::invalid_argument.
+     */
+    template<typename InputIt>
+    AliasTable(InputIt first, InputIt last) {
+        const std::vector<double> weights(first, last);
+        const std::size_t n { weights.size() };
+        const double total { std::accumulate(weights.begin(), weights.end(),
+                                             0.0) };
+        for (const double w : weights) {
+            if (!(w >= 0))
+                throw std::invalid_argument("AliasTable: negative weight");
+        }
+        if (n == 0 || !(total > 0))
+            throw std::invalid_argument("AliasTable: no positive weight");
+
+        range = n;
+        threshold = (0 - range) % range;
+        cols.resize(n);
+        std::vector<double> scaled(n);
+        std::vector<std::size_t> small, large;
+        for (std::size_t i { 0 }; i < n; ++i) {
+            scaled[i] = weights[i] * static_cast<double>(n) / total;
+            (scaled[i] < 1 ? small : large).push_back(i);
+        }
+        while (!small.empty() && !large.empty()) {
+            const std::size_t lo { small.back() };
+            small.pop_back();
+            const std::size_t hi { large.back() };
+            cols[lo] = { coinThreshold(scaled[lo]), hi };
+            scaled[hi] = (scaled[hi] + scaled[lo]) - 1;
+            if (scaled[hi] < 1) {
+                large.pop_back();
+                small.push_back(hi);
+            }
+        }
+        // leftovers have probability 1 up to rounding
+        for (const std::size_t i : small)
+            cols[i] = { coin_one, i };
+        for (const std::size_t i : large)
+            cols[i] = { coin_one, i };
+    }
+
+    AliasTable(std::initializer_list<double> weights) :
+        AliasTable(weights.begin(), weights.end()) {}
+
+    template<typename URBG>
+    std::size_t operator()(URBG& g) const {
+        impl::U64Product prod { impl::mul64x64(impl::draw64(g), range) };
+        while (prod.lo < threshold)
+            prod = impl::mul64x64(impl::draw64(g), range);
+        const Column& col { cols[prod.hi] };
+        return (impl::draw64(g) >> 11) < col.coin ? prod.hi : col.alias;
+    }
+
+    template<typename URBG, typename OutputIt>
+    void generate(URBG& g, OutputIt first, OutputIt last) const {
+        for (; first != last; ++first)
+            *first = (*this)(g);
+    }
+
+    std::size_t size() const { return cols.size(); }
+
+private:
+    static constexpr std::uint64_t coin_one { std::uint64_t{ 1 } << 53 };
+
+    static std::uint64_t coinThreshold(const double prob) {
+        return prob >= 1 ? coin_one :
+            static_cast<std::uint64_t>(prob * static_cast<double>(coin_one));
+    }
+
+    struct Column {
+        std::uint64_t coin;  // column kept if 53 coin bits fall below this
+        std::size_t alias;
+    };
+
+    std::vector<Column> cols;
+    std::uint64_t range;      // n
+    std::uint64_t threshold;  // 2^64 % n
+};
+
+/*
+ * @brief Shuffles [first, last) in cache-sized pieces over `thread_ct`
+ *   threads: every element is scattered to a uniformly random bucket, then each
+ *   bucket is shuffled on its own by batchedShuffle().
+ *
+ * @notes Random bucket labels followed by independent uniform orders within
+ *   buckets give a uniform permutation. Buckets are sized to about 512 KiB, so
+ *   after one streaming scatter all swaps hit cache, unlike a plain
+ *   Fisher-Yates over a large array, which misses on almost every swap.
+ *   The bucket count and the per-chunk and per-bucket engines (seeded from
+ *   draws of `g`) depend only on the input size, so for a given state of `g`
+ *   the result is the same for any `thread_ct`.
+ *   Needs scratch space of one value_type and 2 bytes per element, and a
+ *   value_type that is default constructible and move assignable. Ranges
+ *   under 2 MiB, too small to benefit, are shuffled in place by
+ *   batchedShuffle().
+ */
+template<typename RandomIt, typename URBG>
+void parallelShuffle(RandomIt first, RandomIt last, URBG& g,
+                     std::size_t thread_ct = std::thread::hardware_concurrency()) {
+    using ValueT = typename std::iterator_traits<RandomIt>::value_type;
+    constexpr std::size_t min_bucketed_bytes { std::size_t{ 2 } << 20 };
+    constexpr std::size_t bucket_bytes { std::size_t{ 512 } << 10 };
+    constexpr std::size_t min_bucket_ct { 64 };
+    constexpr std::size_t max_bucket_ct { 4096 };  // labels fit 16 bits
+    constexpr std::size_t chunk_ct { 64 };
+
+    const std::size_t n { static_cast<std::size_t>(last - first) };
+    if (n * sizeof(ValueT) < min_bucketed_bytes) {
+        batchedShuffle(first, last, g);
+        return;
+    }
+    std::size_t bucket_ct { min_bucket_ct };
+    while (bucket_ct < max_bucket_ct &&
+           bucket_ct * bucket_bytes < n * sizeof(ValueT))
+        bucket_ct *= 2;
+    const std::size_t chunk_sz { (n + chunk_ct - 1) / chunk_ct };
+
+    std::vector<std::uint64_t> seeds(chunk_ct + bucket_ct);
+    for (std::uint64_t& seed_val : seeds)
+        seed_val = impl::draw64(g);
+
+    // label every element, counting per chunk and bucket
+    std::unique_ptr<std::uint16_t[]> labels { new std::uint16_t[n] };
+    std::vector<std::size_t> counts(chunk_ct * bucket_ct, 0);
+    impl::forEachTaskParallel(chunk_ct, thread_ct, [&](const std::size_t c) {
+        URBG rng { impl::seededEngine<URBG>(seeds[c]) };
+        std::size_t* chunk_counts { &counts[c * bucket_ct] };
+        const std::size_t end { std::min(n, (c + 1) * chunk_sz) };
+        for (std::size_t i { c * chunk_sz }; i < end; i += 4) {
+            // bucket_ct is a power of two, so 16-bit slices are exact labels
+            const std::uint64_t word { impl::draw64(rng) };
+            for (std::size_t j { 0 }; j < 4 && i + j < end; ++j) {
+                const std::uint16_t label { static_cast<std::uint16_t>(
+                        (word >> (16 * j)) & (bucket_ct - 1)) };
+                labels[i + j] = label;
+                ++chunk_counts[label];
+            }
+        }
+    });
+
+    // bucket-major offsets, so each chunk scatters to its own slots
+    std::vector<std::size_t> bucket_starts(bucket_ct + 1, 0);
+    std::vector<std::size_t> offsets(chunk_ct * bucket_ct);
+    std::size_t pos { 0 };
+    for (std::size_t b { 0 }; b < bucket_ct; ++b) {
+        bucket_starts[b] = pos;
+        for (std::size_t c { 0 }; c < chunk_ct; ++c) {
+            offsets[c * bucket_ct + b] = pos;
+            pos += counts[c * bucket_ct + b];
+        }
+    }
+    bucket_starts[bucket_ct] = pos;
+
+    std::unique_ptr<ValueT[]> scratch { new ValueT[n] };
+    impl::forEachTaskParallel(chunk_ct, thread_ct, [&](const std::size_t c) {
+        std::size_t* chunk_offsets { &offsets[c * bucket_ct] };
+        const std::size_t end { std::min(n, (c + 1) * chunk_sz) };
+        for (std::size_t i { c * chunk_sz }; i < end; ++i)
+            scratch[chunk_offsets[labels[i]]++] = std::move(first[i]);
+    });
+
+    impl::forEachTaskParallel(bucket_ct, thread_ct, [&](const std::size_t b) {
+        URBG rng { impl::seededEngine<URBG>(seeds[chunk_ct + b]) };
+        ValueT* bucket_first { scratch.get() + bucket_starts[b] };
+        ValueT* bucket_last { scratch.get() + bucket_starts[b + 1] };
+        batchedShuffle(bucket_first, bucket_last, rng);
+        std::move(bucket_first, bucket_last, first + bucket_starts[b]);
+    });
+}
+
+
+#endif  // RANDSAMPLING_HH
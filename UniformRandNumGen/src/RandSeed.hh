@@ -0,0 +1,113 @@
+#ifndef RANDSEED_HH
+#define RANDSEED_HH
+
+
+#if __cplusplus < 201703L
+#error "C++17 and above required due to use of if constexpr and \
+std::is_constructible_v"
+#endif
+
+#include "SplitMix64.hh"  // impl::splitMix64Next
+
+#include <atomic>
+#include <cerrno>       // errno, EINTR
+#include <cstdint>      // uint32_t, uint64_t
+#include <limits>       // numeric_limits
+#include <random>       // random_device, seed_seq
+#include <type_traits>  // is_constructible_v
+
+#if defined(__linux__) && defined(__has_include)
+#    if __has_include(<sys/random.h>)
+#include <sys/random.h>  // getrandom
+#define RANDSEED_HAVE_GETRANDOM 1
+#    endif
+#endif
+
+/*
+ * Seed sources for constructing generators and engines without holding a
+ *   std::random_device, eg `UniformRandIntGen<int> gen { 0, 9, processSeed() };`
+ */
+
+/*
+ * @brief 64 bits from a single getrandom(2) call, or from a temporary
+ *   std::random_device where getrandom is unavailable or fails.
+ */
+inline std::uint64_t getrandomSeed() {
+#ifdef RANDSEED_HAVE_GETRANDOM
+    std::uint64_t seed_val;
+    ssize_t ret;
+    do {
+        ret = getrandom(&seed_val, sizeof(seed_val), 0);
+    } while (ret == -1 && errno == EINTR);
+    if (ret == static_cast<ssize_t>(sizeof(seed_val)))
+        return seed_val;
+#endif
+    std::random_device rd;
+    const std::uint64_t hi { rd() };
+    return (hi << 32) | static_cast<std::uint32_t>(rd());
+}
+
+namespace impl {
+
+struct ProcessSeedState {
+    std::atomic<std::uint64_t> master { getrandomSeed() };
+    std::atomic<std::uint64_t> counter { 0 };
+};
+
+inline ProcessSeedState& processSeedState() {
+    static ProcessSeedState state {};
+    return state;
+}
+
+/*
+ * @brief Constructs an engine from a 64-bit seed.
+ *
+ * @notes The std engines (recognized by accepting a std::seed_seq) seed from
+ *   one word and may truncate it, so for those with words narrower than 64
+ *   bits the seed's halves are folded together first. Seeding them through a
+ *   std::seed_seq instead would cost more than the std::random_device it
+ *   replaces.
+ */
+template<typename EngineT>
+EngineT seededEngine(const std::uint64_t seed_val) {
+    if constexpr (std::is_constructible_v<EngineT, std::seed_seq&> &&
+                  EngineT::max() < std::numeric_limits<std::uint64_t>::max()) {
+        using result_type = typename EngineT::result_type;
+        return EngineT { static_cast<result_type>(
+                static_cast<std::uint32_t>(seed_val ^ (seed_val >> 32))) };
+    } else {
+        return EngineT { seed_val };
+    }
+}
+
+}  // namespace impl
+
+/*
+ * @brief Distinct seed per call, derived from one process-wide master seed:
+ *   the master is read once from getrandomSeed(), then each call costs one
+ *   relaxed atomic increment and a splitmix64 mix.
+ *
+ * @notes As splitmix64 mixes a bijection of the counter, no two calls return
+ *   the same seed until the counter wraps at 2^64.
+ */
+inline std::uint64_t processSeed() {
+    impl::ProcessSeedState& state { impl::processSeedState() };
+    std::uint64_t mix_state {
+        state.master.load(std::memory_order_relaxed) +
+        state.counter.fetch_add(1, std::memory_order_relaxed) *
+        0x9e3779b97f4a7c15 };
+    return impl::splitMix64Next(mix_state);
+}
+
+/*
+ * @brief Replaces the processSeed() master and restarts its sequence, to make
+ *   a run reproducible.
+ */
+inline void setProcessSeed(const std::uint64_t master_seed) {
+    impl::ProcessSeedState& state { impl::processSeedState() };
+    state.master.store(master_seed, std::memory_order_relaxed);
+    state.counter.store(0, std::memory_order_relaxed);
+}
+
+
+#endif  // RANDSEED_HH
@@ -0,0 +1,126 @@
+#ifndef RANDSTREAMPOOL_HH
+#define RANDSTREAMPOOL_HH
+
+
+#if __cplusplus < 201703L
+#error "C++17 and above required due to use of inline variables and \
+std::void_t"
+#endif
+
+#include "RandSeed.hh"
+#include "Xoshiro256pp.hh"
+
+#include <atomic>
+#include <cstddef>      // size_t
+#include <cstdint>      // uint64_t
+#include <type_traits>  // void_t, true_type, false_type
+#include <utility>      // declval
+
+namespace impl {
+
+template<typename EngineT, typename = void>
+struct has_jump : std::false_type {};
+
+template<typename EngineT>
+struct has_jump<EngineT, std::void_t<decltype(std::declval<EngineT&>().jump())>> :
+        std::true_type {};
+
+// 0 reserved to mark thread-local slots not yet bound to any pool
+inline std::atomic<std::uint64_t> next_rand_stream_pool_id { 1 };
+
+}  // namespace impl
+
+/*
+ * @brief Hands out per-worker substreams of one engine, all derived
+ *   deterministically from a single master seed.
+ *
+ * @notes For engines with jump() (such as Xoshiro256pp), stream `i` is the
+ *   master engine advanced by `i` jumps, so substreams are guaranteed not to
+ *   overlap for 2^128 draws each. Other engines are instead seeded by
+ *   splitmix64 hashes of (master seed, `i`), which are independent in practice
+ *   but carry no such guarantee.
+ *   stream() is const and so safe to call concurrently. local() binds a
+ *   thread-local engine per calling thread without locking; only one pool per
+ *   EngineT is bound per thread at a time, so alternating local() between two
+ *   pools of the same engine type rebinds (and restarts) the stream each time.
+ */
+template<typename EngineT = Xoshiro256pp>
+class RandStreamPool {
+public:
+    explicit RandStreamPool(std::uint64_t master_seed) :
+        master_seed{ master_seed },
+        id{ impl::next_rand_stream_pool_id.fetch_add(
+                1, std::memory_order_relaxed) },
+        next_index{ 0 } {}
+
+    RandStreamPool(const RandStreamPool&) = delete;
+    RandStreamPool& operator=(const RandStreamPool&) = delete;
+
+    /*
+     * @brief Returns a fresh copy of substream `index`, identical for every
+     *   pool with the same master seed.
+     */
+    EngineT stream(std::size_t index) const {
+        if constexpr (impl::has_jump<EngineT>::value) {
+            EngineT engine { master_seed };
+            for (; index != 0; --index)
+                engine.jump();
+            return engine;
+        } else {
+            std::uint64_t seed_state { master_seed };
+            std::uint64_t index_state { index };
+            std::uint64_t mixer { impl::splitMix64Next(seed_state) ^
+                impl::splitMix64Next(index_state) };
+            return impl::seededEngine<EngineT>(impl::splitMix64Next(mixer));
+        }
+    }
+
+    /*
+     * @brief Returns this thread's engine, binding the next unclaimed
+     *   substream on first use. Substream assignment follows the order in
+     *   which threads first call local(), so use local(index) where results
+     *   must be reproducible.
+     */
+    EngineT& local() {
+        LocalSlot& slot { localSlot() };
+        if (slot.pool_id != id)
+            bind(slot, next_index.fetch_add(1, std::memory_order_relaxed));
+        return slot.engine;
+    }
+
+    /*
+     * @brief Returns this thread's engine, binding substream `index` on first
+     *   use, eg a worker's index in a thread pool.
+     */
+    EngineT& local(std::size_t index) {
+        LocalSlot& slot { localSlot() };
+        if (slot.pool_id != id)
+            bind(slot, index);
+        return slot.engine;
+    }
+
+    std::uint64_t seed() const { return master_seed; }
+
+private:
+    struct LocalSlot {
+        std::uint64_t pool_id { 0 };
+        EngineT engine {};
+    };
+
+    static LocalSlot& localSlot() {
+        thread_local LocalSlot slot {};
+        return slot;
+    }
+
+    void bind(LocalSlot& slot, std::size_t index) const {
+        slot.engine = stream(index);
+        slot.pool_id = id;
+    }
+
+    const std::uint64_t master_seed;
+    const std::uint64_t id;
+    std::atomic<std::size_t> next_index;
+};
+
+
+#endif  // RANDSTREAMPOOL_HH
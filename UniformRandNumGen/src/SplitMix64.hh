@@ -0,0 +1,72 @@
+#ifndef SPLITMIX64_HH
+#define SPLITMIX64_HH
+
+
+#include <cstdint>      // uint64_t
+#include <limits>       // numeric_limits
+
+/*
+ * splitmix64 by Sebastiano Vigna, adapted from the public domain reference
+ *   implementation:
+ *   - https://prng.di.unimi.it/splitmix64.c
+ */
+
+namespace impl {
+
+/*
+ * @brief Advances a splitmix64 state and returns its next output; also used
+ *   to expand a single seed word into larger engine states, as recommended by
+ *   the xoshiro authors.
+ */
+constexpr std::uint64_t splitMix64Next(std::uint64_t& state) {
+    std::uint64_t z { (state += 0x9e3779b97f4a7c15) };
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+}  // namespace impl
+
+/*
+ * @brief splitmix64 engine, satisfying UniformRandomBitGenerator.
+ *
+ * @notes 8 bytes of state and a period of 2^64; every seed is valid, and
+ *   discard() is O(1) as the state is a Weyl sequence.
+ */
+class SplitMix64 {
+public:
+    using result_type = std::uint64_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    constexpr SplitMix64() :SplitMix64(0) {}
+    constexpr explicit SplitMix64(std::uint64_t seed_val) :s{ seed_val } {}
+
+    constexpr void seed(std::uint64_t seed_val) { s = seed_val; }
+
+    constexpr result_type operator()() { return impl::splitMix64Next(s); }
+
+    constexpr void discard(unsigned long long z) {
+        s += 0x9e3779b97f4a7c15 * z;
+    }
+
+    constexpr std::uint64_t state() const { return s; }
+
+    friend constexpr bool operator==(const SplitMix64& lhs,
+                                     const SplitMix64& rhs) {
+        return lhs.s == rhs.s;
+    }
+    friend constexpr bool operator!=(const SplitMix64& lhs,
+                                     const SplitMix64& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    std::uint64_t s;
+};
+
+
+#endif  // SPLITMIX64_HH
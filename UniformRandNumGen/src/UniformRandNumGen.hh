@@ -7,46 +7,177 @@
 std::is_integral_v and std::is_floating_point_v"
 #endif
 
+#include "LemireUniformIntDist.hh"
+#include "MantissaUniformRealDist.hh"
+#include "RandSeed.hh"
+
+#include <cstdint>     // uint64_t
 #include <random>
 #include <type_traits>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
 
 // Note: virtual function table often creates performance overhead, see:
 //   - https://stackoverflow.com/a/667680
-template<typename T>
+//   For hot loops prefer the StaticUniformRandNumGen family below.
+// EngineT may be any UniformRandomBitGenerator constructible from a seed
+//   value, for example the SIMD Xoshiro256ppX4 in Xoshiro256pp.hh, or for a
+//   small footprint the 8-16 byte SplitMix64, Pcg32 or Xoshiro128pp.
+// Default construction seeds from a temporary std::random_device; to avoid
+//   that cost, pass a seed, eg from processSeed() or getrandomSeed() in
+//   RandSeed.hh, or an already seeded engine.
+template<typename T, typename EngineT = std::mt19937>
 class UniformRandNumGen {
 public:
-    UniformRandNumGen() :rd{}, rng{rd()} {}
+    UniformRandNumGen() :rng{std::random_device{}()} {}
+    explicit UniformRandNumGen(std::uint64_t seed_val) :
+        rng{impl::seededEngine<EngineT>(seed_val)} {}
+    explicit UniformRandNumGen(const EngineT& engine) :rng{engine} {}
     virtual ~UniformRandNumGen() {}
     virtual T operator()() = 0;
-private:
-    std::random_device rd;     // only used once to initialise (seed) engine
 protected:
     // The default_random_engine (minstd_rand0 or
     //   std::linear_congruential_engine<std::uint_fast32_t, 16807, 0,
     //   2147483647> in the GNU implementation) seems to not be
     //   seeded/produces the same values at runtime for every compilation;
     //   using Marsenne instead.
-    std::mt19937 rng;          // random-number engine used (Mersenne-Twister)
+    EngineT rng;               // random-number engine used (Mersenne-Twister by default)
 };
 
-template<typename IntT,
+template<typename IntT, typename EngineT = std::mt19937,
          typename = std::enable_if_t<std::is_integral_v<IntT>>>
-class UniformRandIntGen : public UniformRandNumGen<IntT> {
+class UniformRandIntGen : public UniformRandNumGen<IntT, EngineT> {
 public:
     UniformRandIntGen(IntT low, IntT high) :dist{low, high} {}
+    UniformRandIntGen(IntT low, IntT high, std::uint64_t seed_val) :
+        UniformRandNumGen<IntT, EngineT>(seed_val), dist{low, high} {}
+    UniformRandIntGen(IntT low, IntT high, const EngineT& engine) :
+        UniformRandNumGen<IntT, EngineT>(engine), dist{low, high} {}
     IntT operator()() { return dist(this->rng); }
 private:
-    std::uniform_int_distribution<IntT> dist;
+    LemireUniformIntDist<IntT> dist;
 };
 
-template<typename RealT,
+template<typename RealT, typename EngineT = std::mt19937,
          typename = std::enable_if_t<std::is_floating_point_v<RealT>>>
-class UniformRandRealGen : public UniformRandNumGen<RealT> {
+class UniformRandRealGen : public UniformRandNumGen<RealT, EngineT> {
 public:
     UniformRandRealGen(RealT low, RealT high) :dist{low, high} {}
+    UniformRandRealGen(RealT low, RealT high, std::uint64_t seed_val) :
+        UniformRandNumGen<RealT, EngineT>(seed_val), dist{low, high} {}
+    UniformRandRealGen(RealT low, RealT high, const EngineT& engine) :
+        UniformRandNumGen<RealT, EngineT>(engine), dist{low, high} {}
     RealT operator()() { return dist(this->rng); }
 private:
-    std::uniform_real_distribution<RealT> dist;
+    MantissaUniformRealDist<RealT> dist;
+};
+
+/*
+ * @brief Vtable-free counterpart to UniformRandNumGen, using the curiously
+ *   recurring template pattern so that every draw resolves at compile time.
+ *
+ * @notes DerivedT must provide `T draw()`, which operator() forwards to, and
+ *   may shadow drawBulk() when its distribution has a faster batched path;
+ *   by default generate() calls draw() per element. As calls are static they
+ *   can be inlined into the fill loop along with the engine and distribution.
+ *   There is no common polymorphic base, so use UniformRandNumGen where type
+ *   erasure is needed.
+ *   Without a vptr or std::random_device, these are trivially copyable when
+ *   EngineT is, so that they can be packed densely in arrays.
+ */
+template<typename DerivedT, typename T, typename EngineT = std::mt19937>
+class StaticUniformRandNumGen {
+public:
+    T operator()() { return derived().draw(); }
+
+    template<typename OutputIt>
+    void generate(OutputIt first, OutputIt last) {
+        derived().drawBulk(first, last);
+    }
+
+#if __cplusplus >= 202002L
+    void generate(std::span<T> out) { generate(out.begin(), out.end()); }
+#endif
+
+protected:
+    // seeding device is a temporary, as only used once
+    StaticUniformRandNumGen() :rng{std::random_device{}()} {}
+    // eg from processSeed() or getrandomSeed()
+    explicit StaticUniformRandNumGen(std::uint64_t seed_val) :
+        rng{impl::seededEngine<EngineT>(seed_val)} {}
+    // eg a substream from RandStreamPool
+    explicit StaticUniformRandNumGen(const EngineT& engine) :rng{engine} {}
+    // non-virtual, so derived objects are not to be deleted via base pointer
+    ~StaticUniformRandNumGen() = default;
+
+    EngineT rng;               // random-number engine used (Mersenne-Twister by default)
+
+    template<typename OutputIt>
+    void drawBulk(OutputIt first, OutputIt last) {
+        DerivedT& gen { derived() };
+        for (; first != last; ++first)
+            *first = gen.draw();
+    }
+
+private:
+    DerivedT& derived() { return static_cast<DerivedT&>(*this); }
+};
+
+template<typename IntT, typename EngineT = std::mt19937,
+         typename = std::enable_if_t<std::is_integral_v<IntT>>>
+class StaticUniformRandIntGen :
+        public StaticUniformRandNumGen<StaticUniformRandIntGen<IntT, EngineT>,
+                                       IntT, EngineT> {
+    friend class StaticUniformRandNumGen<StaticUniformRandIntGen<IntT, EngineT>,
+                                         IntT, EngineT>;
+public:
+    StaticUniformRandIntGen(IntT low, IntT high) :dist{low, high} {}
+    StaticUniformRandIntGen(IntT low, IntT high, std::uint64_t seed_val) :
+        StaticUniformRandNumGen<StaticUniformRandIntGen<IntT, EngineT>,
+                                IntT, EngineT>(seed_val),
+        dist{low, high} {}
+    StaticUniformRandIntGen(IntT low, IntT high, const EngineT& engine) :
+        StaticUniformRandNumGen<StaticUniformRandIntGen<IntT, EngineT>,
+                                IntT, EngineT>(engine),
+        dist{low, high} {}
+private:
+    IntT draw() { return dist(this->rng); }
+
+    template<typename OutputIt>
+    void drawBulk(OutputIt first, OutputIt last) {
+        dist.generate(this->rng, first, last);
+    }
+
+    LemireUniformIntDist<IntT> dist;
+};
+
+template<typename RealT, typename EngineT = std::mt19937,
+         typename = std::enable_if_t<std::is_floating_point_v<RealT>>>
+class StaticUniformRandRealGen :
+        public StaticUniformRandNumGen<StaticUniformRandRealGen<RealT, EngineT>,
+                                       RealT, EngineT> {
+    friend class StaticUniformRandNumGen<StaticUniformRandRealGen<RealT, EngineT>,
+                                         RealT, EngineT>;
+public:
+    StaticUniformRandRealGen(RealT low, RealT high) :dist{low, high} {}
+    StaticUniformRandRealGen(RealT low, RealT high, std::uint64_t seed_val) :
+        StaticUniformRandNumGen<StaticUniformRandRealGen<RealT, EngineT>,
+                                RealT, EngineT>(seed_val),
+        dist{low, high} {}
+    StaticUniformRandRealGen(RealT low, RealT high, const EngineT& engine) :
+        StaticUniformRandNumGen<StaticUniformRandRealGen<RealT, EngineT>,
+                                RealT, EngineT>(engine),
+        dist{low, high} {}
+private:
+    RealT draw() { return dist(this->rng); }
+
+    template<typename OutputIt>
+    void drawBulk(OutputIt first, OutputIt last) {
+        dist.generate(this->rng, first, last);
+    }
+
+    MantissaUniformRealDist<RealT> dist;
 };
 
 
@@ -0,0 +1,118 @@
+#ifndef XOSHIRO128PP_HH
+#define XOSHIRO128PP_HH
+
+
+#if __cplusplus < 201703L
+#error "C++17 and above required due to use of constexpr std::array access"
+#endif
+
+#include "SplitMix64.hh"  // impl::splitMix64Next
+
+#include <array>
+#include <cstddef>      // size_t
+#include <cstdint>      // uint32_t, uint64_t
+#include <limits>       // numeric_limits
+
+/*
+ * xoshiro128++ by David Blackman and Sebastiano Vigna, adapted from the
+ *   public domain reference implementation:
+ *   - https://prng.di.unimi.it/xoshiro128plusplus.c
+ */
+
+namespace impl {
+
+constexpr std::uint32_t rotl32(const std::uint32_t x, const int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+}  // namespace impl
+
+/*
+ * @brief Scalar xoshiro128++ engine, satisfying UniformRandomBitGenerator.
+ *
+ * @notes 16 bytes of state and a period of 2^128 - 1; jump() and long_jump()
+ *   advance by 2^64 and 2^96 draws respectively.
+ */
+class Xoshiro128pp {
+public:
+    using result_type = std::uint32_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    constexpr Xoshiro128pp() :Xoshiro128pp(0) {}
+    constexpr explicit Xoshiro128pp(std::uint64_t seed_val) :s{} {
+        seed(seed_val);
+    }
+
+    constexpr void seed(std::uint64_t seed_val) {
+        for (std::size_t i { 0 }; i < s.size(); i += 2) {
+            const std::uint64_t word { impl::splitMix64Next(seed_val) };
+            s[i] = static_cast<std::uint32_t>(word);
+            s[i + 1] = static_cast<std::uint32_t>(word >> 32);
+        }
+    }
+
+    constexpr result_type operator()() {
+        const std::uint32_t result { impl::rotl32(s[0] + s[3], 7) + s[0] };
+        const std::uint32_t t { s[1] << 9 };
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = impl::rotl32(s[3], 11);
+        return result;
+    }
+
+    constexpr void discard(unsigned long long z) {
+        for (; z != 0; --z)
+            (*this)();
+    }
+
+    constexpr void jump() {
+        constexpr std::uint32_t jump_poly[] {
+            0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+        applyJump(jump_poly);
+    }
+
+    constexpr void long_jump() {
+        constexpr std::uint32_t long_jump_poly[] {
+            0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662 };
+        applyJump(long_jump_poly);
+    }
+
+    constexpr const std::array<std::uint32_t, 4>& state() const { return s; }
+    constexpr void state(const std::array<std::uint32_t, 4>& new_s) {
+        s = new_s;
+    }
+
+    friend bool operator==(const Xoshiro128pp& lhs, const Xoshiro128pp& rhs) {
+        return lhs.s == rhs.s;
+    }
+    friend bool operator!=(const Xoshiro128pp& lhs, const Xoshiro128pp& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    constexpr void applyJump(const std::uint32_t (&poly)[4]) {
+        std::array<std::uint32_t, 4> acc {};
+        for (const std::uint32_t word : poly) {
+            for (int b { 0 }; b < 32; ++b) {
+                if (word & (std::uint32_t{ 1 } << b)) {
+                    for (std::size_t i { 0 }; i < acc.size(); ++i)
+                        acc[i] ^= s[i];
+                }
+                (*this)();
+            }
+        }
+        s = acc;
+    }
+
+    std::array<std::uint32_t, 4> s;
+};
+
+
+#endif  // XOSHIRO128PP_HH
@@ -0,0 +1,366 @@
+#ifndef XOSHIRO256PP_HH
+#define XOSHIRO256PP_HH
+
+
+#if __cplusplus < 201703L
+#error "C++17 and above required due to use of inline variables"
+#endif
+
+#include "SplitMix64.hh"  // impl::splitMix64Next
+
+#include <array>
+#include <cstddef>      // size_t
+#include <cstdint>      // uint64_t
+#include <limits>       // numeric_limits
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define XOSHIRO256PP_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+/*
+ * xoshiro256++ by David Blackman and Sebastiano Vigna, adapted from the
+ *   public domain reference implementation:
+ *   - https://prng.di.unimi.it/xoshiro256plusplus.c
+ */
+
+namespace impl {
+
+constexpr std::uint64_t rotl64(const std::uint64_t x, const int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+}  // namespace impl
+
+/*
+ * @brief Scalar xoshiro256++ engine, satisfying UniformRandomBitGenerator.
+ *
+ * @notes 32 bytes of state and a period of 2^256 - 1; jump() and long_jump()
+ *   advance by 2^128 and 2^192 draws respectively, to partition the period
+ *   into non-overlapping subsequences.
+ */
+class Xoshiro256pp {
+public:
+    using result_type = std::uint64_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    constexpr Xoshiro256pp() :Xoshiro256pp(0) {}
+    constexpr explicit Xoshiro256pp(std::uint64_t seed_val) :s{} {
+        seed(seed_val);
+    }
+
+    constexpr void seed(std::uint64_t seed_val) {
+        for (std::uint64_t& word : s)
+            word = impl::splitMix64Next(seed_val);
+    }
+
+    constexpr result_type operator()() {
+        const std::uint64_t result { impl::rotl64(s[0] + s[3], 23) + s[0] };
+        const std::uint64_t t { s[1] << 17 };
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = impl::rotl64(s[3], 45);
+        return result;
+    }
+
+    constexpr void discard(unsigned long long z) {
+        for (; z != 0; --z)
+            (*this)();
+    }
+
+    constexpr void jump() {
+        constexpr std::uint64_t jump_poly[] {
+            0x180ec6d33cfd0aba, 0xd5a61266f0c9392c,
+            0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+        applyJump(jump_poly);
+    }
+
+    constexpr void long_jump() {
+        constexpr std::uint64_t long_jump_poly[] {
+            0x76e15d3efefdcbbf, 0xc5004e441c522fb3,
+            0x77710069854ee241, 0x39109bb02acbe635 };
+        applyJump(long_jump_poly);
+    }
+
+    constexpr const std::array<std::uint64_t, 4>& state() const { return s; }
+    constexpr void state(const std::array<std::uint64_t, 4>& new_s) {
+        s = new_s;
+    }
+
+    friend bool operator==(const Xoshiro256pp& lhs, const Xoshiro256pp& rhs) {
+        return lhs.s == rhs.s;
+    }
+    friend bool operator!=(const Xoshiro256pp& lhs, const Xoshiro256pp& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    constexpr void applyJump(const std::uint64_t (&poly)[4]) {
+        std::array<std::uint64_t, 4> acc {};
+        for (const std::uint64_t word : poly) {
+            for (int b { 0 }; b < 64; ++b) {
+                if (word & (std::uint64_t{ 1 } << b)) {
+                    for (std::size_t i { 0 }; i < acc.size(); ++i)
+                        acc[i] ^= s[i];
+                }
+                (*this)();
+            }
+        }
+        s = acc;
+    }
+
+    std::array<std::uint64_t, 4> s;
+};
+
+/*
+ * @brief Instruction set used to advance Xoshiro256ppX4 lanes.
+ *
+ * @notes Auto resolves once per process to the widest backend supported by
+ *   the running CPU. All backends produce identical output.
+ */
+enum class SimdBackend { Auto, Scalar, SSE2, AVX2 };
+
+namespace impl {
+
+/*
+ * @brief State of four xoshiro256++ lanes, stored word-major so that word `w`
+ *   of all lanes fills one 256-bit register.
+ */
+struct alignas(32) XoshiroX4State {
+    std::uint64_t s[4][4];  // [word][lane]
+};
+
+/*
+ * @brief Advances all lanes `steps` times, writing 4 * `steps` outputs
+ *   interleaved by lane.
+ */
+inline void xoshiroX4FillScalar(XoshiroX4State& st, std::uint64_t* out,
+                                std::size_t steps) {
+    for (; steps != 0; --steps, out += 4) {
+        for (int l { 0 }; l < 4; ++l) {
+            out[l] = rotl64(st.s[0][l] + st.s[3][l], 23) + st.s[0][l];
+            const std::uint64_t t { st.s[1][l] << 17 };
+            st.s[2][l] ^= st.s[0][l];
+            st.s[3][l] ^= st.s[1][l];
+            st.s[1][l] ^= st.s[2][l];
+            st.s[0][l] ^= st.s[3][l];
+            st.s[2][l] ^= t;
+            st.s[3][l] = rotl64(st.s[3][l], 45);
+        }
+    }
+}
+
+#ifdef XOSHIRO256PP_X86_SIMD
+
+// SSE2 is baseline on x86-64, but still attributed for 32-bit builds
+#define XOSHIRO_SSE2_ROTL(x, k) \
+    _mm_or_si128(_mm_slli_epi64((x), (k)), _mm_srli_epi64((x), 64 - (k)))
+
+__attribute__((target("sse2")))
+inline void xoshiroX4FillSSE2(XoshiroX4State& st, std::uint64_t* out,
+                              std::size_t steps) {
+    // lanes 0-1 in lo, lanes 2-3 in hi
+    __m128i s0_lo { _mm_load_si128(reinterpret_cast<const __m128i*>(&st.s[0][0])) };
+    __m128i s0_hi { _mm_load_si128(reinterpret_cast<const __m128i*>(&st.s[0][2])) };
+    __m128i s1_lo { _mm_load_si128(reinterpret_cast<const __m128i*>(&st.s[1][0])) };
+    __m128i s1_hi { _mm_load_si128(reinterpret_cast<const __m128i*>(&st.s[1][2])) };
+    __m128i s2_lo { _mm_load_si128(reinterpret_cast<const __m128i*>(&st.s[2][0])) };
+    __m128i s2_hi { _mm_load_si128(reinterpret_cast<const __m128i*>(&st.s[2][2])) };
+    __m128i s3_lo { _mm_load_si128(reinterpret_cast<const __m128i*>(&st.s[3][0])) };
+    __m128i s3_hi { _mm_load_si128(reinterpret_cast<const __m128i*>(&st.s[3][2])) };
+    for (; steps != 0; --steps, out += 4) {
+        const __m128i r_lo { _mm_add_epi64(
+                XOSHIRO_SSE2_ROTL(_mm_add_epi64(s0_lo, s3_lo), 23), s0_lo) };
+        const __m128i r_hi { _mm_add_epi64(
+                XOSHIRO_SSE2_ROTL(_mm_add_epi64(s0_hi, s3_hi), 23), s0_hi) };
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), r_lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2), r_hi);
+        const __m128i t_lo { _mm_slli_epi64(s1_lo, 17) };
+        const __m128i t_hi { _mm_slli_epi64(s1_hi, 17) };
+        s2_lo = _mm_xor_si128(s2_lo, s0_lo);
+        s2_hi = _mm_xor_si128(s2_hi, s0_hi);
+        s3_lo = _mm_xor_si128(s3_lo, s1_lo);
+        s3_hi = _mm_xor_si128(s3_hi, s1_hi);
+        s1_lo = _mm_xor_si128(s1_lo, s2_lo);
+        s1_hi = _mm_xor_si128(s1_hi, s2_hi);
+        s0_lo = _mm_xor_si128(s0_lo, s3_lo);
+        s0_hi = _mm_xor_si128(s0_hi, s3_hi);
+        s2_lo = _mm_xor_si128(s2_lo, t_lo);
+        s2_hi = _mm_xor_si128(s2_hi, t_hi);
+        s3_lo = XOSHIRO_SSE2_ROTL(s3_lo, 45);
+        s3_hi = XOSHIRO_SSE2_ROTL(s3_hi, 45);
+    }
+    _mm_store_si128(reinterpret_cast<__m128i*>(&st.s[0][0]), s0_lo);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&st.s[0][2]), s0_hi);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&st.s[1][0]), s1_lo);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&st.s[1][2]), s1_hi);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&st.s[2][0]), s2_lo);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&st.s[2][2]), s2_hi);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&st.s[3][0]), s3_lo);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&st.s[3][2]), s3_hi);
+}
+
+#undef XOSHIRO_SSE2_ROTL
+
+#define XOSHIRO_AVX2_ROTL(x, k) \
+    _mm256_or_si256(_mm256_slli_epi64((x), (k)), \
+                    _mm256_srli_epi64((x), 64 - (k)))
+
+__attribute__((target("avx2")))
+inline void xoshiroX4FillAVX2(XoshiroX4State& st, std::uint64_t* out,
+                              std::size_t steps) {
+    __m256i s0 { _mm256_load_si256(reinterpret_cast<const __m256i*>(st.s[0])) };
+    __m256i s1 { _mm256_load_si256(reinterpret_cast<const __m256i*>(st.s[1])) };
+    __m256i s2 { _mm256_load_si256(reinterpret_cast<const __m256i*>(st.s[2])) };
+    __m256i s3 { _mm256_load_si256(reinterpret_cast<const __m256i*>(st.s[3])) };
+    for (; steps != 0; --steps, out += 4) {
+        const __m256i result { _mm256_add_epi64(
+                XOSHIRO_AVX2_ROTL(_mm256_add_epi64(s0, s3), 23), s0) };
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), result);
+        const __m256i t { _mm256_slli_epi64(s1, 17) };
+        s2 = _mm256_xor_si256(s2, s0);
+        s3 = _mm256_xor_si256(s3, s1);
+        s1 = _mm256_xor_si256(s1, s2);
+        s0 = _mm256_xor_si256(s0, s3);
+        s2 = _mm256_xor_si256(s2, t);
+        s3 = XOSHIRO_AVX2_ROTL(s3, 45);
+    }
+    _mm256_store_si256(reinterpret_cast<__m256i*>(st.s[0]), s0);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(st.s[1]), s1);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(st.s[2]), s2);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(st.s[3]), s3);
+}
+
+#undef XOSHIRO_AVX2_ROTL
+
+#endif  // XOSHIRO256PP_X86_SIMD
+
+/*
+ * @brief Widest backend supported by the running CPU, resolved once.
+ */
+inline SimdBackend detectedSimdBackend() {
+    static const SimdBackend detected { []() {
+#ifdef XOSHIRO256PP_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return SimdBackend::AVX2;
+        if (__builtin_cpu_supports("sse2"))
+            return SimdBackend::SSE2;
+#endif
+        return SimdBackend::Scalar;
+    }() };
+    return detected;
+}
+
+}  // namespace impl
+
+/*
+ * @brief Four interleaved xoshiro256++ lanes advanced in SIMD registers,
+ *   satisfying UniformRandomBitGenerator.
+ *
+ * @notes Lane `i` starts `i` jumps (i * 2^128 draws) ahead of a scalar
+ *   Xoshiro256pp seeded with the same value, and outputs are interleaved
+ *   lane 0, 1, 2, 3, lane 0, ... Single draws are served from an internal
+ *   buffer refilled in blocks; fill() writes directly to the destination.
+ *   Requesting a backend the CPU does not support falls back to Auto.
+ */
+class Xoshiro256ppX4 {
+public:
+    using result_type = std::uint64_t;
+
+    static constexpr std::size_t lane_ct { 4 };
+    static constexpr std::size_t buffer_sz { 64 };  // multiple of lane_ct
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    Xoshiro256ppX4() :Xoshiro256ppX4(0) {}
+    explicit Xoshiro256ppX4(std::uint64_t seed_val,
+                            SimdBackend backend = SimdBackend::Auto) :
+        st{}, buf{}, pos{ buffer_sz }, simd{ SimdBackend::Scalar } {
+        setBackend(backend);
+        seed(seed_val);
+    }
+
+    void seed(std::uint64_t seed_val) {
+        Xoshiro256pp lane_rng { seed_val };
+        for (std::size_t l { 0 }; l < lane_ct; ++l) {
+            for (std::size_t w { 0 }; w < 4; ++w)
+                st.s[w][l] = lane_rng.state()[w];
+            lane_rng.jump();
+        }
+        pos = buffer_sz;
+    }
+
+    result_type operator()() {
+        if (pos == buffer_sz) {
+            advance(buf.data(), buffer_sz / lane_ct);
+            pos = 0;
+        }
+        return buf[pos++];
+    }
+
+    /*
+     * @brief Writes the next `count` draws to `out`, in the same sequence as
+     *   `count` calls to operator().
+     */
+    void fill(result_type* out, std::size_t count) {
+        // drain buffered draws first to keep the sequence intact
+        for (; pos != buffer_sz && count != 0; --count)
+            *out++ = buf[pos++];
+        const std::size_t steps { count / lane_ct };
+        advance(out, steps);
+        out += steps * lane_ct;
+        for (count -= steps * lane_ct; count != 0; --count)
+            *out++ = (*this)();
+    }
+
+    void discard(unsigned long long z) {
+        for (; z != 0; --z)
+            (*this)();
+    }
+
+    SimdBackend backend() const { return simd; }
+
+    void setBackend(SimdBackend backend) {
+        const SimdBackend detected { impl::detectedSimdBackend() };
+        simd = (backend == SimdBackend::Auto ||
+                static_cast<int>(backend) > static_cast<int>(detected)) ?
+            detected : backend;
+    }
+
+private:
+    void advance(result_type* out, std::size_t steps) {
+        switch (simd) {
+#ifdef XOSHIRO256PP_X86_SIMD
+        case SimdBackend::AVX2:
+            impl::xoshiroX4FillAVX2(st, out, steps);
+            break;
+        case SimdBackend::SSE2:
+            impl::xoshiroX4FillSSE2(st, out, steps);
+            break;
+#endif
+        default:
+            impl::xoshiroX4FillScalar(st, out, steps);
+            break;
+        }
+    }
+
+    impl::XoshiroX4State st;
+    std::array<result_type, buffer_sz> buf;
+    std::size_t pos;
+    SimdBackend simd;
+};
+
+
+#endif  // XOSHIRO256PP_HH
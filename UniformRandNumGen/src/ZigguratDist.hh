@@ -0,0 +1,286 @@
+#ifndef ZIGGURATDIST_HH
+#define ZIGGURATDIST_HH
+
+
+#if __cplusplus < 201703L
+#error "C++17 and above required due to use of constexpr lambdas and \
+variable templates std::is_floating_point_v"
+#endif
+
+#include "ConstexprMath.hh"
+#include "LemireUniformIntDist.hh"     // impl::draw64, impl::is_full_word_engine_v
+#include "MantissaUniformRealDist.hh"  // impl::oneToTwo, impl::fillWords64
+
+#include <algorithm>    // min
+#include <cmath>        // exp, fabs, log
+#include <cstddef>      // size_t
+#include <cstdint>      // uint64_t
+#include <iterator>     // distance, forward_iterator_tag, iterator_traits
+#include <random>       // exponential_distribution, normal_distribution
+#include <type_traits>  // enable_if_t, is_base_of_v
+
+/*
+ * Normal and exponential variates by the ziggurat method, adapted from:
+ *   - Marsaglia and Tsang, "The Ziggurat Method for Generating Random
+ *     Variables", Journal of Statistical Software 5(8) (2000)
+ *   - Doornik, "An Improved Ziggurat Method to Generate Normal Random
+ *     Samples" (2005), for drawing layer and position from independent bits
+ */
+
+namespace impl {
+
+constexpr std::size_t ziggurat_layer_ct { 256 };
+
+/*
+ * @brief Layers of equal area V under a decreasing density f, the base layer
+ *   (0) also covering the tail beyond R.
+ */
+struct ZigguratTables {
+    double x[ziggurat_layer_ct + 1] {};    // layer widths; x[0] = V / f(R)
+    double ratio[ziggurat_layer_ct] {};    // x[i + 1] / x[i]
+    double f[ziggurat_layer_ct + 1] {};    // f(x[i])
+};
+
+template<typename DensityF, typename InverseF>
+constexpr ZigguratTables makeZigguratTables(const double r, const double v,
+                                            DensityF density,
+                                            InverseF inverse) {
+    ZigguratTables t {};
+    t.x[0] = v / density(r);
+    t.x[1] = r;
+    for (std::size_t i { 2 }; i < ziggurat_layer_ct; ++i) {
+        const double y { v / t.x[i - 1] + density(t.x[i - 1]) };
+        // the top layer may round to just above the peak
+        t.x[i] = y < 1 ? inverse(y) : 0;
+    }
+    t.x[ziggurat_layer_ct] = 0;
+    for (std::size_t i { 0 }; i < ziggurat_layer_ct; ++i)
+        t.ratio[i] = t.x[i + 1] / t.x[i];
+    for (std::size_t i { 0 }; i <= ziggurat_layer_ct; ++i)
+        t.f[i] = density(t.x[i]);
+    return t;
+}
+
+// 256-layer constants from Marsaglia and Tsang, with V for the normal
+//   recomputed to double precision from R, as R f(R) + integral of f beyond R
+constexpr double ziggurat_normal_r { 3.6541528853610088 };
+constexpr double ziggurat_normal_v { 0.004928673233974658 };
+constexpr double ziggurat_exp_r { 7.69711747013104972 };
+constexpr double ziggurat_exp_v { 0.0039496598225815571993 };
+
+// unnormalized densities exp(-x^2 / 2) and exp(-x)
+constexpr ZigguratTables ziggurat_normal_tables { makeZigguratTables(
+        ziggurat_normal_r, ziggurat_normal_v,
+        [](const double x) { return constexprExp(-0.5 * x * x); },
+        [](const double y) { return constexprSqrt(-2 * constexprLog(y)); }) };
+
+constexpr ZigguratTables ziggurat_exp_tables { makeZigguratTables(
+        ziggurat_exp_r, ziggurat_exp_v,
+        [](const double x) { return constexprExp(-x); },
+        [](const double y) { return -constexprLog(y); }) };
+
+/*
+ * @brief Standard normal variate, trying `word` first: its low 8 bits pick a
+ *   layer and its top 52 a signed position within it. Further words are drawn
+ *   from `g` only on rejection (about 1% of calls).
+ */
+template<typename URBG>
+double zigguratNormal(std::uint64_t word, URBG& g) {
+    const ZigguratTables& t { ziggurat_normal_tables };
+    for (;; word = draw64(g)) {
+        const std::size_t i { word & (ziggurat_layer_ct - 1) };
+        const double u { 2 * oneToTwo<double>(word) - 3 };  // [-1, 1)
+        const double x { u * t.x[i] };
+        if (std::fabs(u) < t.ratio[i])
+            return x;
+        if (i == 0) {
+            // tail beyond R, by Marsaglia's method
+            double a, b;
+            do {
+                a = -std::log(unitOpenClosed(g)) / ziggurat_normal_r;
+                b = -std::log(unitOpenClosed(g));
+            } while (b + b < a * a);
+            return u < 0 ? -(ziggurat_normal_r + a) : ziggurat_normal_r + a;
+        }
+        // wedge between the layer's rectangle and the curve
+        if (t.f[i] + unitClosedOpen(g) * (t.f[i + 1] - t.f[i]) <
+            std::exp(-0.5 * x * x))
+            return x;
+    }
+}
+
+/*
+ * @brief Standard exponential variate, trying `word` first as for
+ *   zigguratNormal().
+ */
+template<typename URBG>
+double zigguratExponential(std::uint64_t word, URBG& g) {
+    const ZigguratTables& t { ziggurat_exp_tables };
+    for (;; word = draw64(g)) {
+        const std::size_t i { word & (ziggurat_layer_ct - 1) };
+        const double u { oneToTwo<double>(word) - 1 };  // [0, 1)
+        const double x { u * t.x[i] };
+        if (u < t.ratio[i])
+            return x;
+        if (i == 0)  // memoryless, so the tail is a shifted exponential
+            return ziggurat_exp_r - std::log(unitOpenClosed(g));
+        if (t.f[i] + unitClosedOpen(g) * (t.f[i + 1] - t.f[i]) < std::exp(-x))
+            return x;
+    }
+}
+
+/*
+ * @brief Fills [first, last) with `from_word(word, g)`, through blocks of
+ *   words from the engine's bulk fill() where it has one, else per value.
+ */
+template<typename URBG, typename OutputIt, typename FromWordF>
+void zigguratGenerate(URBG& g, OutputIt first, OutputIt last,
+                      FromWordF from_word) {
+    using CategoryT = typename std::iterator_traits<OutputIt>::iterator_category;
+    if constexpr (!has_fill<URBG>::value ||
+                  !std::is_base_of_v<std::forward_iterator_tag, CategoryT>) {
+        for (; first != last; ++first)
+            *first = from_word(draw64(g), g);
+    } else {
+        constexpr std::size_t block_sz { 256 };
+        std::uint64_t words[block_sz];
+        for (auto remaining { std::distance(first, last) }; remaining > 0;) {
+            const std::size_t word_ct { std::min<std::size_t>(
+                    block_sz, static_cast<std::size_t>(remaining)) };
+            impl::fillWords64(g, words, word_ct);
+            for (std::size_t i { 0 }; i < word_ct; ++i, ++first)
+                *first = from_word(words[i], g);
+            remaining -= static_cast<decltype(remaining)>(word_ct);
+        }
+    }
+}
+
+}  // namespace impl
+
+/*
+ * @brief Drop-in alternative to std::normal_distribution by the ziggurat
+ *   method: about 99% of draws cost one 64-bit engine word, a table lookup, a
+ *   multiply and a compare, with no log, sqrt or trig call.
+ *
+ * @notes Tables are computed at compile time. Values are computed in double
+ *   precision and rounded to RealT.
+ *   generate() draws blocks of engine words through the engine's bulk fill()
+ *   where it has one (such as Xoshiro256ppX4), in which case the words for
+ *   rejected draws come after the block and the sequence differs from that
+ *   of repeated operator() calls.
+ *   Engines whose outputs are not full 32- or 64-bit words are drawn from by
+ *   std::normal_distribution instead.
+ */
+template<typename RealT = double,
+         typename = std::enable_if_t<std::is_floating_point_v<RealT>>>
+class ZigguratNormalDist {
+public:
+    using result_type = RealT;
+
+    constexpr explicit ZigguratNormalDist(RealT mean = 0, RealT stddev = 1) :
+        mu{ mean }, sigma{ stddev } {}
+
+    template<typename URBG>
+    RealT operator()(URBG& g) const {
+        if constexpr (!impl::is_full_word_engine_v<URBG>)
+            return std::normal_distribution<RealT>{ mu, sigma }(g);
+        else
+            return fromWord(impl::draw64(g), g);
+    }
+
+    template<typename URBG, typename OutputIt>
+    void generate(URBG& g, OutputIt first, OutputIt last) const {
+        if constexpr (!impl::is_full_word_engine_v<URBG>) {
+            std::normal_distribution<RealT> dist { mu, sigma };
+            for (; first != last; ++first)
+                *first = dist(g);
+        } else {
+            impl::zigguratGenerate(g, first, last,
+                                   [this](const std::uint64_t word, URBG& eng) {
+                                       return fromWord(word, eng);
+                                   });
+        }
+    }
+
+    constexpr RealT mean() const { return mu; }
+    constexpr RealT stddev() const { return sigma; }
+
+    friend constexpr bool operator==(const ZigguratNormalDist& lhs,
+                                     const ZigguratNormalDist& rhs) {
+        return lhs.mu == rhs.mu && lhs.sigma == rhs.sigma;
+    }
+    friend constexpr bool operator!=(const ZigguratNormalDist& lhs,
+                                     const ZigguratNormalDist& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    template<typename URBG>
+    RealT fromWord(const std::uint64_t word, URBG& g) const {
+        return static_cast<RealT>(mu + sigma * impl::zigguratNormal(word, g));
+    }
+
+    RealT mu;
+    RealT sigma;
+};
+
+/*
+ * @brief Drop-in alternative to std::exponential_distribution by the ziggurat
+ *   method, with the same costs and generate() behavior as ZigguratNormalDist,
+ *   and std::exponential_distribution for engines without full-word outputs.
+ */
+template<typename RealT = double,
+         typename = std::enable_if_t<std::is_floating_point_v<RealT>>>
+class ZigguratExponentialDist {
+public:
+    using result_type = RealT;
+
+    constexpr explicit ZigguratExponentialDist(RealT lambda = 1) :
+        rate{ lambda }, inv_rate{ 1 / lambda } {}
+
+    template<typename URBG>
+    RealT operator()(URBG& g) const {
+        if constexpr (!impl::is_full_word_engine_v<URBG>)
+            return std::exponential_distribution<RealT>{ rate }(g);
+        else
+            return fromWord(impl::draw64(g), g);
+    }
+
+    template<typename URBG, typename OutputIt>
+    void generate(URBG& g, OutputIt first, OutputIt last) const {
+        if constexpr (!impl::is_full_word_engine_v<URBG>) {
+            std::exponential_distribution<RealT> dist { rate };
+            for (; first != last; ++first)
+                *first = dist(g);
+        } else {
+            impl::zigguratGenerate(g, first, last,
+                                   [this](const std::uint64_t word, URBG& eng) {
+                                       return fromWord(word, eng);
+                                   });
+        }
+    }
+
+    constexpr RealT lambda() const { return rate; }
+
+    friend constexpr bool operator==(const ZigguratExponentialDist& lhs,
+                                     const ZigguratExponentialDist& rhs) {
+        return lhs.rate == rhs.rate;
+    }
+    friend constexpr bool operator!=(const ZigguratExponentialDist& lhs,
+                                     const ZigguratExponentialDist& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    template<typename URBG>
+    RealT fromWord(const std::uint64_t word, URBG& g) const {
+        return static_cast<RealT>(inv_rate *
+                                  impl::zigguratExponential(word, g));
+    }
+
+    RealT rate;
+    RealT inv_rate;  // 1 / rate, so as to multiply per draw
+};
+
+
+#endif  // ZIGGURATDIST_HH
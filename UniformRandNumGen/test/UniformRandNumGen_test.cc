@@ -0,0 +1,843 @@
+#if (_CATCH_VERSION_MAJOR == 3)
+  #include <catch2/catch_test_macros.hpp>     // TEST_CASE, SECTION, REQUIRE
+#elif (_CATCH_VERSION_MAJOR == 2)
+  #include <catch2/catch.hpp>
+#endif
+
+#include "UniformRandNumGen.hh"
+#include "CounterUniformRandNumGen.hh"
+#include "LemireUniformIntDist.hh"
+#include "MantissaUniformRealDist.hh"
+#include "NonUniformRandNumGen.hh"
+#include "Pcg32.hh"
+#include "Philox4x32.hh"
+#include "PoissonDist.hh"
+#include "RandSampling.hh"
+#include "RandSeed.hh"
+#include "RandStreamPool.hh"
+#include "SplitMix64.hh"
+#include "Xoshiro128pp.hh"
+#include "Xoshiro256pp.hh"
+#include "ZigguratDist.hh"
+
+#include <algorithm>  // adjacent_find, all_of, count, minmax_element, sort
+#include <array>
+#include <cmath>      // exp, fabs, log, nextafter, sqrt
+#include <limits>     // numeric_limits
+#include <list>
+#include <map>
+#include <numeric>    // accumulate, iota
+#include <stdexcept>  // invalid_argument
+#include <cstdint>    // int64_t, uint32_t, uint64_t
+#include <cstdlib>    // abs
+#include <thread>
+#include <type_traits>  // is_trivially_copyable_v
+#include <vector>
+
+
+TEST_CASE("Virtual generators stay within bounds",
+          "[UniformRandIntGen, UniformRandRealGen]")
+{
+    SECTION("Integers")
+    {
+        UniformRandIntGen<int> gen { -3, 3 };
+        UniformRandNumGen<int>& base { gen };
+        for (int i { 0 }; i < 1000; ++i) {
+            const int n { base() };
+            REQUIRE((n >= -3 && n <= 3));
+        }
+    }
+    SECTION("Reals")
+    {
+        UniformRandRealGen<double> gen { 1.0, 2.0 };
+        UniformRandNumGen<double>& base { gen };
+        for (int i { 0 }; i < 1000; ++i) {
+            const double d { base() };
+            REQUIRE((d >= 1.0 && d < 2.0));
+        }
+    }
+    SECTION("Integers from engines without full-word outputs")
+    {
+        // minstd_rand outputs [1, 2^31 - 2]
+        UniformRandIntGen<int, std::minstd_rand> gen { -3, 3, 11 };
+        std::vector<int> counts(7);
+        for (int i { 0 }; i < 7000; ++i) {
+            const int n { gen() };
+            REQUIRE((n >= -3 && n <= 3));
+            ++counts[n + 3];
+        }
+        REQUIRE(std::count(counts.begin(), counts.end(), 0) == 0);
+
+        StaticUniformRandIntGen<unsigned, std::minstd_rand> static_gen {
+            0, 9, 12 };
+        std::vector<unsigned> draws(1000);
+        static_gen.generate(draws.begin(), draws.end());
+        REQUIRE(std::all_of(draws.begin(), draws.end(),
+                            [](const unsigned n) { return n <= 9; }));
+    }
+    SECTION("Reals from engines without full-word outputs")
+    {
+        // ranlux24 outputs 24-bit words
+        UniformRandRealGen<double, std::ranlux24> gen { 1.0, 2.0, 13 };
+        StaticUniformRandRealGen<float, std::minstd_rand> static_gen {
+            -1.0f, 1.0f, 14 };
+        std::vector<float> draws(1000);
+        static_gen.generate(draws.begin(), draws.end());
+        for (std::size_t i { 0 }; i < draws.size(); ++i) {
+            const double d { gen() };
+            REQUIRE((d >= 1.0 && d < 2.0));
+            REQUIRE((draws[i] >= -1.0f && draws[i] < 1.0f));
+        }
+    }
+    SECTION("Long double reals")
+    {
+        UniformRandRealGen<long double> gen { -2.0L, 3.0L, 15 };
+        long double sum { 0 };
+        for (int i { 0 }; i < 10000; ++i) {
+            const long double d { gen() };
+            REQUIRE((d >= -2.0L && d < 3.0L));
+            sum += d;
+        }
+        REQUIRE(std::fabs(static_cast<double>(sum / 10000) - 0.5) < 0.1);
+
+        const MantissaUniformRealDist<long double> dist { 0.0L, 1.0L };
+        REQUIRE(dist.fromBits(0) == 0.0L);
+        REQUIRE(dist.fromBits(~std::uint64_t { 0 }) < 1.0L);
+    }
+}
+
+TEST_CASE("Static generators stay within bounds",
+          "[StaticUniformRandIntGen, StaticUniformRandRealGen]")
+{
+    SECTION("Single draws")
+    {
+        StaticUniformRandIntGen<unsigned> igen { 10, 20 };
+        StaticUniformRandRealGen<float> rgen { -1.0f, 1.0f };
+        for (int i { 0 }; i < 1000; ++i) {
+            const unsigned n { igen() };
+            const float f { rgen() };
+            REQUIRE((n >= 10 && n <= 20));
+            REQUIRE((f >= -1.0f && f < 1.0f));
+        }
+    }
+    SECTION("Bulk fill by iterator range")
+    {
+        StaticUniformRandIntGen<long> igen { -5, 5 };
+        std::vector<long> v(4096, 100);
+        igen.generate(v.begin(), v.end());
+        REQUIRE(std::all_of(v.begin(), v.end(),
+                            [](const long n) { return n >= -5 && n <= 5; }));
+    }
+#if __cplusplus >= 202002L
+    SECTION("Bulk fill by span")
+    {
+        StaticUniformRandRealGen<double> rgen { 0.0, 0.5 };
+        std::vector<double> v(4096, 1.0);
+        rgen.generate(std::span<double>{ v });
+        REQUIRE(std::all_of(v.begin(), v.end(),
+                            [](const double d) { return d >= 0.0 && d < 0.5; }));
+    }
+#endif
+}
+
+TEST_CASE("xoshiro256++ engines",
+          "[Xoshiro256pp, Xoshiro256ppX4]")
+{
+    SECTION("Scalar engine matches reference output")
+    {
+        Xoshiro256pp rng {};
+        rng.state({ 1, 2, 3, 4 });
+        REQUIRE(rng() == 41943041);
+        REQUIRE(rng() == 58720359);
+        REQUIRE(rng() == 3588806011781223);
+        REQUIRE(rng() == 3591011842654386);
+    }
+    SECTION("Lanes are jumped scalar streams")
+    {
+        Xoshiro256ppX4 rng4 { 42 };
+        Xoshiro256pp lanes[4] { Xoshiro256pp{ 42 } };
+        for (int l { 1 }; l < 4; ++l) {
+            lanes[l] = lanes[l - 1];
+            lanes[l].jump();
+        }
+        for (int i { 0 }; i < 100; ++i) {
+            for (Xoshiro256pp& lane : lanes)
+                REQUIRE(rng4() == lane());
+        }
+    }
+    SECTION("All backends and fill() produce the same sequence")
+    {
+        constexpr std::size_t count { 1003 };
+        std::vector<std::uint64_t> expected(count);
+        Xoshiro256ppX4 scalar { 7, SimdBackend::Scalar };
+        REQUIRE(scalar.backend() == SimdBackend::Scalar);
+        for (std::uint64_t& word : expected)
+            word = scalar();
+        for (const SimdBackend backend : { SimdBackend::Auto, SimdBackend::SSE2,
+                                           SimdBackend::AVX2 }) {
+            Xoshiro256ppX4 rng4 { 7, backend };
+            std::vector<std::uint64_t> actual(count);
+            // misaligned with buffer and lanes on purpose
+            actual[0] = rng4();
+            rng4.fill(actual.data() + 1, 517);
+            rng4.fill(actual.data() + 518, count - 518);
+            REQUIRE(actual == expected);
+        }
+    }
+    SECTION("Plugs into generators")
+    {
+        UniformRandIntGen<int, Xoshiro256ppX4> igen { 0, 9 };
+        StaticUniformRandRealGen<double, Xoshiro256ppX4> rgen { -2.0, 2.0 };
+        std::vector<double> v(1000);
+        rgen.generate(v.begin(), v.end());
+        REQUIRE(std::all_of(v.begin(), v.end(),
+                            [](const double d) { return d >= -2.0 && d < 2.0; }));
+        for (int i { 0 }; i < 1000; ++i) {
+            const int n { igen() };
+            REQUIRE((n >= 0 && n <= 9));
+        }
+    }
+}
+
+TEST_CASE("Substreams from one master seed",
+          "[RandStreamPool]")
+{
+    SECTION("Jumpable engines are jumped master streams")
+    {
+        const RandStreamPool<Xoshiro256pp> pool { 99 };
+        Xoshiro256pp expected { 99 };
+        for (std::size_t i { 0 }; i < 4; ++i) {
+            REQUIRE(pool.stream(i) == expected);
+            expected.jump();
+        }
+    }
+    SECTION("Other engines are seeded deterministically and distinctly")
+    {
+        const RandStreamPool<std::mt19937> pool_a { 5 };
+        const RandStreamPool<std::mt19937> pool_b { 5 };
+        const RandStreamPool<std::mt19937> pool_c { 6 };
+        REQUIRE(pool_a.stream(3) == pool_b.stream(3));
+        REQUIRE(pool_a.stream(3) != pool_a.stream(4));
+        REQUIRE(pool_a.stream(3) != pool_c.stream(3));
+    }
+    SECTION("Thread-local engines")
+    {
+        RandStreamPool<Xoshiro256pp> pool { 1234 };
+        constexpr std::size_t thread_ct { 4 };
+        std::vector<std::uint64_t> first_draws(thread_ct);
+        std::vector<char> same_engine(thread_ct);
+        std::vector<std::thread> threads;
+        // Catch2 assertions are not thread-safe, so only record results here
+        for (std::size_t i { 0 }; i < thread_ct; ++i) {
+            threads.emplace_back([&pool, &first_draws, &same_engine, i]() {
+                Xoshiro256pp& rng { pool.local(i) };
+                same_engine[i] = (&rng == &pool.local(i));
+                first_draws[i] = rng();
+            });
+        }
+        for (std::thread& t : threads)
+            t.join();
+        for (std::size_t i { 0 }; i < thread_ct; ++i) {
+            REQUIRE(same_engine[i]);
+            REQUIRE(first_draws[i] == pool.stream(i)());
+        }
+
+        SECTION("Unindexed local() claims next unclaimed substream")
+        {
+            RandStreamPool<Xoshiro256pp> other_pool { 4321 };
+            REQUIRE(other_pool.local() == other_pool.stream(0));
+        }
+    }
+    SECTION("Generators constructed from substreams")
+    {
+        const RandStreamPool<Xoshiro256pp> pool { 8 };
+        StaticUniformRandIntGen<int, Xoshiro256pp> gen_a { 0, 1000,
+                                                           pool.stream(2) };
+        StaticUniformRandIntGen<int, Xoshiro256pp> gen_b { 0, 1000,
+                                                           pool.stream(2) };
+        UniformRandIntGen<int, Xoshiro256pp> gen_c { 0, 1000, pool.stream(2) };
+        for (int i { 0 }; i < 100; ++i) {
+            const int n { gen_a() };
+            REQUIRE(n == gen_b());
+            REQUIRE(n == gen_c());
+        }
+    }
+}
+
+TEST_CASE("Counter-based random access",
+          "[Philox4x32, CounterUniformRandIntGen, CounterUniformRandRealGen]")
+{
+    SECTION("Philox4x32-10 matches Random123 known answers")
+    {
+        using ctr_t = Philox4x32::counter_type;
+        REQUIRE(Philox4x32::block({ 0, 0 }, ctr_t{ 0, 0, 0, 0 }) ==
+                ctr_t{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 });
+        REQUIRE(Philox4x32::block({ 0xffffffff, 0xffffffff },
+                                  ctr_t{ 0xffffffff, 0xffffffff,
+                                         0xffffffff, 0xffffffff }) ==
+                ctr_t{ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd });
+        REQUIRE(Philox4x32::block({ 0xa4093822, 0x299f31d0 },
+                                  ctr_t{ 0x243f6a88, 0x85a308d3,
+                                         0x13198a2e, 0x03707344 }) ==
+                ctr_t{ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 });
+    }
+    SECTION("Engine seeks in O(1)")
+    {
+        Philox4x32 seq { 77 };
+        std::vector<std::uint32_t> words(103);
+        for (std::uint32_t& word : words)
+            word = seq();
+        for (const std::uint64_t pos : { 0, 1, 4, 6, 57, 102 }) {
+            Philox4x32 rng { 77 };
+            rng.discard(pos);
+            REQUIRE(rng() == words[pos]);
+            rng.seek(3);
+            REQUIRE(rng() == words[3]);
+        }
+    }
+    SECTION("Output independent of partitioning")
+    {
+        // narrow range to exercise rejection and redraws
+        const CounterUniformRandIntGen<std::int64_t> igen {
+            -3, (std::int64_t{ 1 } << 62) + (std::int64_t{ 1 } << 61), 2024 };
+        const CounterUniformRandRealGen<double> rgen { -1.0, 1.0, 2024 };
+        constexpr std::size_t count { 1001 };
+        std::vector<std::int64_t> whole_i(count);
+        std::vector<double> whole_r(count);
+        igen.generate(0, whole_i.begin(), whole_i.end());
+        rgen.generate(0, whole_r.begin(), whole_r.end());
+
+        std::vector<std::int64_t> parts_i(count);
+        std::vector<double> parts_r(count);
+        // uneven partitions, generated out of order
+        const std::size_t bounds[] { 0, 1, 2, 5, 333, 334, 700, count };
+        for (std::size_t b { std::size(bounds) - 1 }; b != 0; --b) {
+            igen.generate(bounds[b - 1], parts_i.begin() + bounds[b - 1],
+                          parts_i.begin() + bounds[b]);
+            rgen.generate(bounds[b - 1], parts_r.begin() + bounds[b - 1],
+                          parts_r.begin() + bounds[b]);
+        }
+        REQUIRE(parts_i == whole_i);
+        REQUIRE(parts_r == whole_r);
+        for (std::size_t i { 0 }; i < count; i += 97) {
+            REQUIRE(igen[i] == whole_i[i]);
+            REQUIRE(rgen[i] == whole_r[i]);
+        }
+        REQUIRE(std::all_of(whole_r.begin(), whole_r.end(),
+                            [](const double d) { return d >= -1.0 && d < 1.0; }));
+    }
+    SECTION("Bounds")
+    {
+        const CounterUniformRandIntGen<unsigned char> gen { 250, 255, 1 };
+        std::vector<unsigned char> v(1000);
+        gen.generate(12345, v.begin(), v.end());
+        REQUIRE(std::all_of(v.begin(), v.end(),
+                            [](const unsigned char c) { return c >= 250; }));
+        REQUIRE(std::count(v.begin(), v.end(), 250) > 0);
+        REQUIRE(std::count(v.begin(), v.end(), 255) > 0);
+    }
+}
+
+TEST_CASE("Division-free bounded integers",
+          "[LemireUniformIntDist, FixedLemireUniformIntDist]")
+{
+    // loose chi-squared style check that every value is drawn near equally
+    const auto require_near_uniform { [](const std::vector<int>& draws,
+                                         const int low, const int high) {
+        std::vector<std::size_t> counts(high - low + 1);
+        for (const int n : draws) {
+            REQUIRE((n >= low && n <= high));
+            ++counts[n - low];
+        }
+        const double expected { static_cast<double>(draws.size()) /
+                                static_cast<double>(counts.size()) };
+        const auto [min_ct, max_ct] {
+            std::minmax_element(counts.begin(), counts.end()) };
+        REQUIRE(static_cast<double>(*min_ct) > expected * 0.9);
+        REQUIRE(static_cast<double>(*max_ct) < expected * 1.1);
+    } };
+
+    SECTION("Batch sizes follow range")
+    {
+        REQUIRE(LemireUniformIntDist<int>{ 0, 1 }.batchSize() == 16);
+        REQUIRE(LemireUniformIntDist<int>{ 0, 255 }.batchSize() == 7);
+        REQUIRE(LemireUniformIntDist<unsigned>{ 0, 0xffffffff }.batchSize() == 1);
+        REQUIRE(LemireUniformIntDist<std::int64_t>{
+                std::numeric_limits<std::int64_t>::min(),
+                std::numeric_limits<std::int64_t>::max() }.batchSize() == 1);
+        static_assert(FixedLemireUniformIntDist<short, -2, 997>::batchSize() == 6);
+    }
+    SECTION("Single draws")
+    {
+        Xoshiro256pp rng64 { 3 };
+        std::mt19937 rng32 { 3 };
+        const LemireUniformIntDist<int> dist { -7, 12 };
+        std::vector<int> draws(200000);
+        for (std::size_t i { 0 }; i < draws.size(); ++i)
+            draws[i] = (i % 2 == 0) ? dist(rng64) : dist(rng32);
+        require_near_uniform(draws, -7, 12);
+    }
+    SECTION("Batched draws")
+    {
+        Xoshiro256pp rng { 4 };
+        const LemireUniformIntDist<int> dist { 100, 105 };
+        std::vector<int> draws(200001);
+        dist.generate(rng, draws.begin(), draws.end());
+        require_near_uniform(draws, 100, 105);
+
+        const FixedLemireUniformIntDist<int, 0, 2> fixed_dist {};
+        fixed_dist.generate(rng, draws.begin(), draws.end());
+        require_near_uniform(draws, 0, 2);
+    }
+    SECTION("Wide and full ranges")
+    {
+        Xoshiro256pp rng { 5 };
+        const LemireUniformIntDist<std::int64_t> wide {
+            -(std::int64_t{ 1 } << 40), std::int64_t{ 1 } << 40 };
+        const LemireUniformIntDist<std::uint64_t> full {
+            0, std::numeric_limits<std::uint64_t>::max() };
+        bool any_high_bit { false };
+        for (int i { 0 }; i < 1000; ++i) {
+            const std::int64_t n { wide(rng) };
+            REQUIRE((n >= -(std::int64_t{ 1 } << 40) &&
+                     n <= std::int64_t{ 1 } << 40));
+            any_high_bit |= (full(rng) >> 63) != 0;
+        }
+        REQUIRE(any_high_bit);
+    }
+}
+
+TEST_CASE("Seeding without a per-object random_device",
+          "[getrandomSeed, processSeed, setProcessSeed]")
+{
+    SECTION("Explicit seeds are reproducible")
+    {
+        UniformRandIntGen<int> gen_a { 0, 1 << 20, 11 };
+        StaticUniformRandIntGen<int> gen_b { 0, 1 << 20, 11 };
+        StaticUniformRandRealGen<double, Xoshiro256pp> gen_c { 0.0, 1.0, 11 };
+        StaticUniformRandRealGen<double, Xoshiro256pp> gen_d { 0.0, 1.0, 11 };
+        for (int i { 0 }; i < 100; ++i) {
+            REQUIRE(gen_a() == gen_b());
+            REQUIRE(gen_c() == gen_d());
+        }
+    }
+    SECTION("Process seeds are distinct and resettable")
+    {
+        setProcessSeed(2718);
+        std::vector<std::uint64_t> seeds(1000);
+        for (std::uint64_t& seed : seeds)
+            seed = processSeed();
+        std::vector<std::uint64_t> sorted { seeds };
+        std::sort(sorted.begin(), sorted.end());
+        REQUIRE(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+
+        setProcessSeed(2718);
+        REQUIRE(processSeed() == seeds[0]);
+        REQUIRE(processSeed() == seeds[1]);
+    }
+    SECTION("getrandom seeds vary")
+    {
+        REQUIRE(getrandomSeed() != getrandomSeed());
+    }
+}
+
+TEST_CASE("Small-state engines",
+          "[SplitMix64, Pcg32, Xoshiro128pp]")
+{
+    SECTION("Reference outputs")
+    {
+        SplitMix64 splitmix { 1234567 };
+        REQUIRE(splitmix() == 6457827717110365317u);
+        REQUIRE(splitmix() == 3203168211198807973u);
+        REQUIRE(splitmix() == 9817491932198370423u);
+
+        Pcg32 pcg { 42, 54 };
+        REQUIRE(pcg() == 0xa15c02b7);
+        REQUIRE(pcg() == 0x7b47f409);
+        REQUIRE(pcg() == 0xba1d3330);
+
+        Xoshiro128pp xoshiro {};
+        xoshiro.state({ 1, 2, 3, 4 });
+        REQUIRE(xoshiro() == 641);
+        REQUIRE(xoshiro() == 1573767);
+    }
+    SECTION("Jump-ahead matches sequential draws")
+    {
+        Pcg32 seq { 9 };
+        Pcg32 skip { 9 };
+        SplitMix64 seq64 { 9 };
+        SplitMix64 skip64 { 9 };
+        for (int i { 0 }; i < 1000; ++i) {
+            seq();
+            seq64();
+        }
+        skip.discard(1000);
+        skip64.discard(1000);
+        REQUIRE(seq == skip);
+        REQUIRE(seq64 == skip64);
+
+        const RandStreamPool<Xoshiro128pp> pool { 3 };
+        Xoshiro128pp jumped { 3 };
+        jumped.jump();
+        REQUIRE(pool.stream(1) == jumped);
+    }
+    SECTION("Static generators are small and trivially copyable")
+    {
+        static_assert(sizeof(SplitMix64) == 8);
+        static_assert(sizeof(Pcg32) == 16);
+        static_assert(sizeof(Xoshiro128pp) == 16);
+        static_assert(std::is_trivially_copyable_v<
+                      StaticUniformRandIntGen<int, SplitMix64>>);
+        static_assert(std::is_trivially_copyable_v<
+                      StaticUniformRandIntGen<int, Pcg32>>);
+        static_assert(std::is_trivially_copyable_v<
+                      StaticUniformRandRealGen<float, Xoshiro128pp>>);
+        static_assert(std::is_trivially_copyable_v<
+                      StaticUniformRandRealGen<double, Xoshiro256pp>>);
+
+        std::vector<StaticUniformRandIntGen<int, Pcg32>> gens;
+        for (std::uint64_t i { 0 }; i < 100; ++i)
+            gens.emplace_back(-1, 1, i);
+        for (auto& gen : gens) {
+            const int n { gen() };
+            REQUIRE((n >= -1 && n <= 1));
+        }
+    }
+}
+
+TEST_CASE("Uniform reals from mantissa bits",
+          "[MantissaUniformRealDist]")
+{
+    SECTION("Extreme bits map to the ends of [low, high)")
+    {
+        const MantissaUniformRealDist<double> unit { 0.0, 1.0 };
+        REQUIRE(unit.fromBits(0) == 0.0);
+        REQUIRE(unit.fromBits(~std::uint64_t{ 0 }) ==
+                1.0 - std::numeric_limits<double>::epsilon());
+        const MantissaUniformRealDist<float> funit { -1.0f, 1.0f };
+        REQUIRE(funit.fromBits(0) == -1.0f);
+        REQUIRE(funit.fromBits(~std::uint64_t{ 0 }) < 1.0f);
+    }
+    SECTION("Rounding never reaches high")
+    {
+        // spans of a few ulps, where unclamped scaling would round up to high
+        const double high { 1.0 + 4 * std::numeric_limits<double>::epsilon() };
+        const MantissaUniformRealDist<double> narrow { 1.0, high };
+        REQUIRE(narrow.fromBits(~std::uint64_t{ 0 }) < high);
+        const MantissaUniformRealDist<double> single { 1.0,
+                                                       std::nextafter(1.0, 2.0) };
+        REQUIRE(single.fromBits(~std::uint64_t{ 0 }) == 1.0);
+        const MantissaUniformRealDist<double> empty { 2.0, 2.0 };
+        REQUIRE(empty.fromBits(12345) == 2.0);
+
+        Xoshiro256pp rng { 17 };
+        std::vector<double> v(10000);
+        narrow.generate(rng, v.begin(), v.end());
+        REQUIRE(std::all_of(v.begin(), v.end(), [&](const double d) {
+            return d >= 1.0 && d < high; }));
+    }
+    SECTION("Bulk fill matches single draws")
+    {
+        const MantissaUniformRealDist<double> dist { -2.0, 3.0 };
+        Xoshiro256pp single_rng { 5 };
+        Xoshiro256pp bulk_rng { 5 };
+        std::vector<double> v(1001);
+        dist.generate(bulk_rng, v.begin(), v.end());
+        for (const double d : v)
+            REQUIRE(d == dist(single_rng));
+
+        // engines with their own fill() (Xoshiro256ppX4) or 32-bit words
+        Xoshiro256ppX4 x4_single_rng { 5 };
+        Xoshiro256ppX4 x4_bulk_rng { 5 };
+        dist.generate(x4_bulk_rng, v.begin(), v.end());
+        for (const double d : v)
+            REQUIRE(d == dist(x4_single_rng));
+
+        const MantissaUniformRealDist<float> fdist { 0.0f, 10.0f };
+        Pcg32 pcg_single_rng { 5 };
+        Pcg32 pcg_bulk_rng { 5 };
+        std::vector<float> fv(1001);
+        fdist.generate(pcg_bulk_rng, fv.begin(), fv.end());
+        for (const float f : fv)
+            REQUIRE(f == fdist(pcg_single_rng));
+    }
+    SECTION("Bulk floats take both halves of 64-bit words")
+    {
+        const MantissaUniformRealDist<float> dist { 0.0f, 1.0f };
+        Xoshiro256pp word_rng { 8 };
+        Xoshiro256pp bulk_rng { 8 };
+        std::vector<float> v(1001, 2.0f);
+        dist.generate(bulk_rng, v.begin(), v.end());
+        for (std::size_t i { 0 }; i < v.size(); i += 2) {
+            const std::uint64_t word { word_rng() };
+            REQUIRE(v[i] == dist.fromBits(word));
+            if (i + 1 < v.size())
+                REQUIRE(v[i + 1] == dist.fromBits(word << 32));
+        }
+    }
+    SECTION("Mean near midpoint")
+    {
+        StaticUniformRandRealGen<double, Xoshiro256pp> gen { 10.0, 20.0, 3 };
+        std::vector<double> v(100000);
+        gen.generate(v.begin(), v.end());
+        const double mean { std::accumulate(v.begin(), v.end(), 0.0) /
+                            static_cast<double>(v.size()) };
+        REQUIRE((mean > 14.95 && mean < 15.05));
+        REQUIRE(std::all_of(v.begin(), v.end(), [](const double d) {
+            return d >= 10.0 && d < 20.0; }));
+    }
+}
+
+namespace {
+
+struct SampleMoments {
+    double mean;
+    double variance;
+};
+
+template<typename T>
+SampleMoments sampleMoments(const std::vector<T>& v) {
+    double sum { 0 }, sum_sq { 0 };
+    for (const T x : v) {
+        sum += static_cast<double>(x);
+        sum_sq += static_cast<double>(x) * static_cast<double>(x);
+    }
+    const double n { static_cast<double>(v.size()) };
+    return { sum / n, sum_sq / n - (sum / n) * (sum / n) };
+}
+
+}  // namespace
+
+TEST_CASE("Ziggurat and Poisson distributions",
+          "[ZigguratNormalDist, ZigguratExponentialDist, PoissonDist]")
+{
+    constexpr std::size_t sample_ct { 1000000 };
+
+    SECTION("Compile-time tables match runtime math")
+    {
+        const impl::ZigguratTables& t { impl::ziggurat_normal_tables };
+        REQUIRE(t.x[1] == impl::ziggurat_normal_r);
+        for (std::size_t i { 1 }; i < impl::ziggurat_layer_ct; ++i) {
+            REQUIRE(std::fabs(t.f[i] - std::exp(-0.5 * t.x[i] * t.x[i])) <
+                    1e-15);
+            // every layer has area V
+            const double area { t.x[i] * (t.f[i + 1] - t.f[i]) };
+            REQUIRE(std::fabs(area - impl::ziggurat_normal_v) < 1e-12);
+        }
+        const impl::ZigguratTables& e { impl::ziggurat_exp_tables };
+        for (std::size_t i { 1 }; i < impl::ziggurat_layer_ct; ++i) {
+            REQUIRE(std::fabs(e.f[i] - std::exp(-e.x[i])) < 1e-15);
+            const double area { e.x[i] * (e.f[i + 1] - e.f[i]) };
+            REQUIRE(std::fabs(area - impl::ziggurat_exp_v) < 1e-12);
+        }
+        for (int k { 1 }; k < 100; ++k) {
+            REQUIRE(std::fabs(impl::logFactorial(k) - std::lgamma(k + 1.0)) <
+                    1e-10 * k);
+        }
+    }
+    SECTION("Normal moments and tails")
+    {
+        StaticNormalRandGen<double, Xoshiro256pp> gen { 2.0, 3.0, 11 };
+        std::vector<double> v(sample_ct);
+        gen.generate(v.begin(), v.end());
+        const SampleMoments m { sampleMoments(v) };
+        REQUIRE(std::fabs(m.mean - 2.0) < 0.01);
+        REQUIRE(std::fabs(m.variance - 9.0) < 0.05);
+        // P(|Z| > 1) = 0.3173, P(|Z| > 4) = 6.3e-5, the latter from the tail
+        const auto beyond { [&](const double z) {
+            return static_cast<double>(std::count_if(
+                v.begin(), v.end(), [&](const double x) {
+                    return std::fabs(x - 2.0) > 3.0 * z; })) / sample_ct; } };
+        REQUIRE(std::fabs(beyond(1) - 0.3173) < 0.002);
+        REQUIRE((beyond(4) > 3e-5 && beyond(4) < 1.2e-4));
+    }
+    SECTION("Exponential moments and tail")
+    {
+        ZigguratExponentialDist<double> dist { 0.5 };
+        Xoshiro256pp rng { 12 };
+        std::vector<double> v(sample_ct);
+        dist.generate(rng, v.begin(), v.end());
+        REQUIRE(std::all_of(v.begin(), v.end(),
+                            [](const double x) { return x >= 0; }));
+        const SampleMoments m { sampleMoments(v) };
+        REQUIRE(std::fabs(m.mean - 2.0) < 0.01);
+        REQUIRE(std::fabs(m.variance - 4.0) < 0.05);
+        // P(X > 16) = exp(-8) = 3.4e-4, the tail starting at 2 * 7.697
+        const double tail { static_cast<double>(std::count_if(
+            v.begin(), v.end(), [](const double x) { return x > 16; })) /
+            sample_ct };
+        REQUIRE((tail > 2.5e-4 && tail < 4.3e-4));
+    }
+    SECTION("Poisson moments for small and large means")
+    {
+        for (const double mean : { 0.5, 4.0, 10.0, 75.0, 1e6 }) {
+            StaticPoissonRandGen<long, Xoshiro256pp> gen { mean, 13 };
+            std::vector<long> v(sample_ct / 4);
+            gen.generate(v.begin(), v.end());
+            REQUIRE(std::all_of(v.begin(), v.end(),
+                                [](const long k) { return k >= 0; }));
+            const SampleMoments m { sampleMoments(v) };
+            const double std_err { std::sqrt(mean / v.size()) };
+            REQUIRE(std::fabs(m.mean - mean) < 5 * std_err);
+            REQUIRE(std::fabs(m.variance / mean - 1) < 0.03);
+        }
+    }
+    SECTION("Bulk fill through engine fill() and single draws agree in law")
+    {
+        ZigguratNormalDist<float> dist {};
+        Xoshiro256ppX4 rng { 14 };
+        std::vector<float> bulk(sample_ct / 4), single(sample_ct / 4);
+        dist.generate(rng, bulk.begin(), bulk.end());
+        for (float& x : single)
+            x = dist(rng);
+        const SampleMoments bulk_m { sampleMoments(bulk) };
+        const SampleMoments single_m { sampleMoments(single) };
+        REQUIRE(std::fabs(bulk_m.mean) < 0.01);
+        REQUIRE(std::fabs(single_m.mean) < 0.01);
+        REQUIRE(std::fabs(bulk_m.variance - 1) < 0.02);
+        REQUIRE(std::fabs(single_m.variance - 1) < 0.02);
+    }
+    SECTION("Engines without full-word outputs")
+    {
+        // minstd_rand outputs [1, 2^31 - 2], ranlux24 24-bit words
+        NormalRandGen<double, std::minstd_rand> normal { 2.0, 3.0, 15 };
+        StaticExponentialRandGen<float, std::ranlux24> exponential { 0.5f, 16 };
+        StaticPoissonRandGen<int, std::minstd_rand> poisson { 40.0, 17 };
+        std::vector<double> normal_v(sample_ct / 10);
+        for (double& x : normal_v)
+            x = normal();
+        std::vector<float> exp_v(sample_ct / 10);
+        exponential.generate(exp_v.begin(), exp_v.end());
+        std::vector<int> poisson_v(sample_ct / 10);
+        poisson.generate(poisson_v.begin(), poisson_v.end());
+        const SampleMoments normal_m { sampleMoments(normal_v) };
+        REQUIRE(std::fabs(normal_m.mean - 2.0) < 0.05);
+        REQUIRE(std::fabs(normal_m.variance - 9.0) < 0.2);
+        REQUIRE(std::all_of(exp_v.begin(), exp_v.end(),
+                            [](const float x) { return x >= 0; }));
+        REQUIRE(std::fabs(sampleMoments(exp_v).mean - 2.0) < 0.05);
+        REQUIRE(std::fabs(sampleMoments(poisson_v).mean - 40.0) < 0.2);
+    }
+    SECTION("Virtual generators")
+    {
+        NormalRandGen<double> normal { 0.0, 1.0, 1 };
+        ExponentialRandGen<double> exponential { 1.0, 2 };
+        PoissonRandGen<int> poisson { 3.0, 3 };
+        UniformRandNumGen<double>& base { exponential };
+        for (int i { 0 }; i < 1000; ++i) {
+            normal();
+            REQUIRE(base() >= 0);
+            REQUIRE(poisson() >= 0);
+        }
+    }
+}
+
+TEST_CASE("Shuffling and sampling",
+          "[batchedShuffle, partialShuffle, reservoirSample, AliasTable, \
+parallelShuffle]")
+{
+    constexpr int trial_ct { 60000 };
+
+    SECTION("Shuffle yields every permutation equally often")
+    {
+        Xoshiro256pp rng { 21 };
+        std::map<std::array<int, 3>, int> perm_counts;
+        for (int t { 0 }; t < trial_ct; ++t) {
+            std::array<int, 3> a { 0, 1, 2 };
+            batchedShuffle(a.begin(), a.end(), rng);
+            ++perm_counts[a];
+        }
+        REQUIRE(perm_counts.size() == 6);
+        for (const auto& [perm, count] : perm_counts)
+            REQUIRE(std::abs(count - trial_ct / 6) < 500);
+    }
+    SECTION("Large shuffles are permutations")
+    {
+        // large enough for batches of 3, 2 and 1 index per word
+        Pcg32 rng { 22 };
+        std::vector<std::uint32_t> v(3000000);
+        std::iota(v.begin(), v.end(), 0);
+        batchedShuffle(v.begin(), v.end(), rng);
+        REQUIRE(v[0] != 0);
+        std::sort(v.begin(), v.end());
+        for (std::uint32_t i { 0 }; i < v.size(); ++i)
+            REQUIRE(v[i] == i);
+    }
+    SECTION("Partial shuffle samples each element equally")
+    {
+        Xoshiro256pp rng { 23 };
+        std::array<int, 10> counts {};
+        for (int t { 0 }; t < trial_ct; ++t) {
+            std::array<int, 10> a {};
+            std::iota(a.begin(), a.end(), 0);
+            partialShuffle(a.begin(), a.begin() + 3, a.end(), rng);
+            for (int i { 0 }; i < 3; ++i)
+                ++counts[a[i]];
+            std::sort(a.begin(), a.end());
+            REQUIRE(a[9] == 9);
+        }
+        for (const int count : counts)
+            REQUIRE(std::abs(count - trial_ct * 3 / 10) < 600);
+    }
+    SECTION("Reservoir samples each element equally")
+    {
+        Xoshiro256pp rng { 24 };
+        std::vector<int> source(40);
+        std::iota(source.begin(), source.end(), 0);
+        const std::list<int> single_pass(source.begin(), source.end());
+        std::array<int, 40> vec_counts {}, list_counts {};
+        std::array<int, 5> sample {};
+        for (int t { 0 }; t < trial_ct; ++t) {
+            REQUIRE(reservoirSample(source.begin(), source.end(),
+                                    sample.begin(), 5, rng) == 5);
+            for (const int x : sample)
+                ++vec_counts[x];
+            reservoirSample(single_pass.begin(), single_pass.end(),
+                            sample.begin(), 5, rng);
+            for (const int x : sample)
+                ++list_counts[x];
+        }
+        for (int i { 0 }; i < 40; ++i) {
+            REQUIRE(std::abs(vec_counts[i] - trial_ct / 8) < 400);
+            REQUIRE(std::abs(list_counts[i] - trial_ct / 8) < 400);
+        }
+        REQUIRE(reservoirSample(source.begin(), source.begin() + 3,
+                                sample.begin(), 5, rng) == 3);
+    }
+    SECTION("Alias table follows weights")
+    {
+        const AliasTable table { 1.0, 2.0, 3.0, 4.0, 0.0 };
+        REQUIRE(table.size() == 5);
+        Xoshiro256pp rng { 25 };
+        std::vector<std::size_t> draws(100000);
+        table.generate(rng, draws.begin(), draws.end());
+        for (std::size_t i { 0 }; i < 5; ++i) {
+            const double freq { static_cast<double>(
+                std::count(draws.begin(), draws.end(), i)) / draws.size() };
+            REQUIRE(std::fabs(freq - static_cast<double>(i + 1) / 10 *
+                              (i < 4 ? 1 : 0)) < 0.005);
+        }
+        REQUIRE_THROWS_AS(AliasTable({ 0.0, 0.0 }), std::invalid_argument);
+        REQUIRE_THROWS_AS(AliasTable({ 1.0, -1.0 }), std::invalid_argument);
+    }
+    SECTION("Parallel shuffle is a permutation independent of thread count")
+    {
+        std::vector<std::uint64_t> single(1 << 19), multi(1 << 19);
+        std::iota(single.begin(), single.end(), 0);
+        std::iota(multi.begin(), multi.end(), 0);
+        Xoshiro256pp single_rng { 26 };
+        Xoshiro256pp multi_rng { 26 };
+        parallelShuffle(single.begin(), single.end(), single_rng, 1);
+        parallelShuffle(multi.begin(), multi.end(), multi_rng, 4);
+        REQUIRE(single == multi);
+        // both halves mix: about half of the first half's values move across
+        const auto moved { std::count_if(single.begin(),
+                                         single.begin() + single.size() / 2,
+                                         [&](const std::uint64_t x) {
+                                             return x >= single.size() / 2; }) };
+        REQUIRE(std::abs(moved - static_cast<long>(single.size() / 4)) < 1500);
+        std::sort(single.begin(), single.end());
+        for (std::uint64_t i { 0 }; i < single.size(); ++i)
+            REQUIRE(single[i] == i);
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Compares small reads from many open (page cached) files by one safeLibcCall
+ *   each with batches submitted through LibcBatch, by io_uring and by thread
+ *   pool.
+ */
+
+#include "safeLibcBatch.hh"
+#include "safeLibcCall.hh"
+#include "benchUtils.hh"
+
+#include <array>
+#include <cstdio>    // puts
+#include <string>
+#include <vector>
+
+#include <fcntl.h>   // O_CREAT, O_RDWR
+#include <unistd.h>  // close, pread, unlink
+
+
+namespace {
+
+constexpr std::size_t file_ct { 256 };
+constexpr std::size_t round_ct { 1 << 8 };
+constexpr unsigned read_sz { 64 };
+
+using Buffers = std::vector<std::array<char, read_sz>>;
+
+void benchBatch(const char* const label, const LibcBatchBackend backend,
+                const std::vector<int>& fds, Buffers& bufs) {
+    LibcBatch batch { static_cast<unsigned>(file_ct), backend };
+    printResult(label, nsPerOp([&](std::size_t n) {
+        for (std::size_t i { 0 }; i < n; ++i) {
+            for (std::size_t j { 0 }; j < file_ct; ++j)
+                batch.read(fds[j], bufs[j].data(), read_sz, 0);
+            for (const LibcBatch::Result& result : batch.submit())
+                doNotOptimize(result.value());
+        }
+    }, round_ct));
+}
+
+}  // namespace
+
+int main() {
+    std::vector<std::string> paths;
+    std::vector<int> fds;
+    for (std::size_t i { 0 }; i < file_ct; ++i) {
+        paths.push_back("batch_bench_file" + std::to_string(i));
+        fds.push_back(safeLibcCall(open, "open", ret_eq<-1>{},
+                                   paths.back().c_str(), O_RDWR | O_CREAT,
+                                   0644));
+        safeLibcCall(pwrite, "pwrite", ret_eq<-1>{}, fds.back(),
+                     paths.back().data(), paths.back().size(), 0);
+    }
+    Buffers bufs(file_ct);
+
+    printResult("pread per call, per 256 files", nsPerOp([&](std::size_t n) {
+        for (std::size_t i { 0 }; i < n; ++i) {
+            for (std::size_t j { 0 }; j < file_ct; ++j) {
+                doNotOptimize(safeLibcCall(pread, "pread", ret_eq<-1>{},
+                                           fds[j], bufs[j].data(), read_sz,
+                                           0));
+            }
+        }
+    }, round_ct));
+    if (LibcBatch{}.backend() == LibcBatchBackend::IoUring)
+        benchBatch("LibcBatch io_uring, per 256 files",
+                   LibcBatchBackend::IoUring, fds, bufs);
+    else
+        std::puts("io_uring unavailable");
+    benchBatch("LibcBatch thread pool, per 256 files",
+               LibcBatchBackend::ThreadPool, fds, bufs);
+
+    for (std::size_t i { 0 }; i < file_ct; ++i) {
+        close(fds[i]);
+        unlink(paths[i].c_str());
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Compares stat of many files on tmpfs by one safeLibcCall each with
+ *   bulkLibcCall on pools of 1 to 8 threads; scaling is bounded by the cores
+ *   available, which the benchmark prints.
+ */
+
+#include "safeLibcBulk.hh"
+#include "safeLibcCall.hh"
+#include "benchUtils.hh"
+
+#include <cstdio>    // printf, snprintf
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <fcntl.h>     // O_CREAT, O_WRONLY
+#include <sys/stat.h>  // stat
+#include <unistd.h>    // close, unlink
+
+
+namespace {
+
+constexpr std::size_t file_ct { 4096 };
+constexpr std::size_t round_ct { 1 << 5 };
+
+}  // namespace
+
+int main() {
+    std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+    // tmpfs, so that calls are bound by the kernel rather than a device
+    const std::string dir { access("/dev/shm", W_OK) == 0 ? "/dev/shm/" : "" };
+    std::vector<std::string> paths;
+    for (std::size_t i { 0 }; i < file_ct; ++i) {
+        paths.push_back(dir + "bulk_bench_file" + std::to_string(i));
+        close(safeLibcCall(open, "open", ret_eq<-1>{}, paths.back().c_str(),
+                           O_WRONLY | O_CREAT, 0644));
+    }
+    std::vector<struct stat> stats(file_ct);
+    std::vector<const char*> names;
+    std::vector<std::tuple<const char*, struct stat*>> args;
+    for (std::size_t i { 0 }; i < file_ct; ++i) {
+        names.push_back(paths[i].c_str());
+        args.emplace_back(names.back(), &stats[i]);
+    }
+
+    printResult("stat per call, per 4096 files", nsPerOp([&](std::size_t n) {
+        for (std::size_t i { 0 }; i < n; ++i) {
+            for (std::size_t j { 0 }; j < file_ct; ++j) {
+                doNotOptimize(safeLibcCall(stat, "stat", ret_eq<-1>{},
+                                           paths[j].c_str(), &stats[j]));
+            }
+        }
+    }, round_ct));
+    for (const unsigned thread_ct : { 1u, 2u, 4u, 8u }) {
+        LibcWorkPool pool { thread_ct };
+        char label[64];
+        std::snprintf(label, sizeof(label),
+                      "bulkLibcCall %u threads, per 4096 files", thread_ct);
+        printResult(label, nsPerOp([&](std::size_t n) {
+            for (std::size_t i { 0 }; i < n; ++i) {
+                bulkLibcCall(pool, stat, "stat", ret_eq<-1>{}, args)
+                    .throwIfFailed();
+            }
+        }, round_ct));
+    }
+
+    LibcWorkPool pool {};
+    bulkLibcCall(pool, unlink, "unlink", ret_eq<-1>{}, names).throwIfFailed();
+}
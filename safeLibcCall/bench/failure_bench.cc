@@ -0,0 +1,48 @@
+/*
+ * Compares the cost of routine failures (EAGAIN) reported by exception through
+ *   safeLibcCall with those returned by tryLibcCall.
+ */
+
+#include "safeLibcCall.hh"
+#include "benchUtils.hh"
+
+#include <cerrno>   // EAGAIN
+#include <system_error>
+
+
+namespace {
+
+constexpr std::size_t call_ct { 1 << 20 };
+
+// stands in for a nonblocking read with no data ready
+__attribute__((noinline)) int wouldBlock(int val) {
+    asm volatile("" : "+r"(val));
+    errno = EAGAIN;
+    return -1;
+}
+
+}  // namespace
+
+int main() {
+    printResult("safeLibcCall failure, caught", nsPerOp([](std::size_t n) {
+        std::size_t again_ct { 0 };
+        for (std::size_t i { 0 }; i < n; ++i) {
+            try {
+                safeLibcCall(wouldBlock, "wouldBlock", ret_eq<-1>{},
+                             static_cast<int>(i));
+            } catch (const std::system_error& e) {
+                again_ct += (e.code() == std::errc::resource_unavailable_try_again);
+            }
+        }
+        doNotOptimize(again_ct);
+    }, call_ct));
+    printResult("tryLibcCall failure", nsPerOp([](std::size_t n) {
+        std::size_t again_ct { 0 };
+        for (std::size_t i { 0 }; i < n; ++i) {
+            const auto result { tryLibcCall(wouldBlock, "wouldBlock",
+                                            ret_eq<-1>{}, static_cast<int>(i)) };
+            again_ct += (result.errnoValue() == EAGAIN);
+        }
+        doNotOptimize(again_ct);
+    }, call_ct));
+}
@@ -0,0 +1,77 @@
+/*
+ * Compares ingesting a (page cached) file by readAll into a buffer with
+ *   reading it in place through a MappedFile, under each set of options; each
+ *   round opens (and maps) the file and checksums it.
+ */
+
+#include "safeLibcFile.hh"
+#include "safeLibcIo.hh"
+#include "benchUtils.hh"
+
+#include <cstdint>   // uint64_t
+#include <cstring>   // memcpy
+#include <string>
+#include <vector>
+
+#include <fcntl.h>   // O_CREAT, O_RDONLY, O_WRONLY
+#include <unistd.h>  // unlink
+
+
+namespace {
+
+constexpr std::size_t file_sz { std::size_t{ 1 } << 26 };
+constexpr std::size_t buf_sz { std::size_t{ 1 } << 16 };
+constexpr std::size_t round_ct { 8 };
+constexpr const char* path { "mapped_bench_file" };
+
+std::uint64_t checksum(const char* const data, const std::size_t len) {
+    std::uint64_t sum { 0 };
+    for (std::size_t i { 0 }; i + sizeof(sum) <= len; i += sizeof(sum)) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        sum += word;
+    }
+    return sum;
+}
+
+void benchMapped(const char* const label, const MapOptions& options) {
+    printResult(label, nsPerOp([&](std::size_t n) {
+        for (std::size_t i { 0 }; i < n; ++i) {
+            const MappedFile mapped { path, options };
+            doNotOptimize(checksum(mapped.view().data(), mapped.size()));
+        }
+    }, round_ct));
+}
+
+}  // namespace
+
+int main() {
+    {
+        const UniqueFd fd { path, O_WRONLY | O_CREAT | O_TRUNC, 0644 };
+        const std::string block(buf_sz, 'x');
+        for (std::size_t written { 0 }; written < file_sz; written += buf_sz)
+            writeAll(fd.get(), block.data(), block.size());
+    }
+
+    std::vector<char> buf(buf_sz);
+    printResult("readAll into 64KiB buffer, per 64MiB", nsPerOp([&](std::size_t n) {
+        for (std::size_t i { 0 }; i < n; ++i) {
+            const UniqueFd fd { path, O_RDONLY };
+            std::uint64_t sum { 0 };
+            for (std::size_t left { file_sz }; left > 0; left -= buf_sz) {
+                readAll(fd.get(), buf.data(), buf_sz);
+                sum += checksum(buf.data(), buf_sz);
+            }
+            doNotOptimize(sum);
+        }
+    }, round_ct));
+    benchMapped("MappedFile, per 64MiB", {});
+    benchMapped("MappedFile sequential, per 64MiB",
+                { true, false, false, false, false });
+    benchMapped("MappedFile populate, per 64MiB",
+                { false, false, false, true, false });
+    benchMapped("MappedFile hugepages+prefault, per 64MiB",
+                { false, false, true, false, true });
+
+    unlink(path);
+}
@@ -0,0 +1,68 @@
+/*
+ * Compares the overhead of the std::function-based failure tests with the
+ *   compile-time predicate policies and a raw call, on a trivial stand-in for
+ *   a libc call (to isolate wrapper cost) and on getppid (for scale).
+ */
+
+#include "safeLibcCall.hh"
+#include "benchUtils.hh"
+
+#include <unistd.h>  // getppid
+
+
+namespace {
+
+constexpr std::size_t call_ct { 1 << 24 };
+
+// never fails; noinline so that every variant pays one real call
+__attribute__((noinline)) int fakeLibcCall(int val) {
+    asm volatile("" : "+r"(val));
+    return val;
+}
+
+template<typename CallF>
+void benchCalls(const char* label, CallF&& call) {
+    printResult(label, nsPerOp([&](std::size_t iterations) {
+        int sum { 0 };
+        for (std::size_t i { 0 }; i < iterations; ++i)
+            sum += call(static_cast<int>(i));
+        doNotOptimize(sum);
+    }, call_ct));
+}
+
+}  // namespace
+
+int main() {
+    const LibcRetErrTest<int> ret_err_test { [](const int ret, const int err) {
+        return (ret == -1 || err);
+    } };
+    const LibcRetTest<int> ret_test { [](const int ret) { return ret == -1; } };
+    const LibcErrTest err_test { [](const int err) { return err != 0; } };
+
+    benchCalls("raw call", [](const int i) { return fakeLibcCall(i); });
+    benchCalls("LibcRetErrTest (std::function)", [&](const int i) {
+        return safeLibcCall(fakeLibcCall, "fake", ret_err_test, i); });
+    benchCalls("LibcRetTest (std::function)", [&](const int i) {
+        return safeLibcCall(fakeLibcCall, "fake", ret_test, i); });
+    benchCalls("LibcErrTest (std::function)", [&](const int i) {
+        return safeLibcCall(fakeLibcCall, "fake", err_test, i); });
+    benchCalls("no test (errno only)", [](const int i) {
+        return safeLibcCall(fakeLibcCall, "fake", i); });
+    benchCalls("retErrTest policy", [](const int i) {
+        return safeLibcCall(fakeLibcCall, "fake",
+                            retErrTest([](const int ret, const int err) {
+                                return (ret == -1 || err); }), i); });
+    benchCalls("ret_eq<-1> policy", [](const int i) {
+        return safeLibcCall(fakeLibcCall, "fake", ret_eq<-1>{}, i); });
+    benchCalls("ret_eq<-1> policy, compile-time name", [](const int i) {
+        return safeLibcCall<&fakeLibcCall>(ret_eq<-1>{}, i); });
+    benchCalls("errno_nonzero policy", [](const int i) {
+        return safeLibcCall(fakeLibcCall, "fake", errno_nonzero{}, i); });
+
+    benchCalls("getppid raw", [](int) { return static_cast<int>(getppid()); });
+    benchCalls("getppid LibcRetTest (std::function)", [&](int) {
+        return static_cast<int>(safeLibcCall(getppid, "getppid", LibcRetTest<pid_t>{
+            [](const pid_t ret) { return ret == -1; } })); });
+    benchCalls("getppid ret_eq<-1> policy", [](int) {
+        return static_cast<int>(safeLibcCall(getppid, "getppid", ret_eq<-1>{})); });
+}
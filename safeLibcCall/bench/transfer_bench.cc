@@ -0,0 +1,50 @@
+/*
+ * Compares writing many small records by one write call each with coalescing
+ *   them into writevAll calls, to a pipe drained by another thread.
+ */
+
+#include "safeLibcIo.hh"
+#include "benchUtils.hh"
+
+#include <array>
+#include <thread>
+
+#include <unistd.h>  // close, pipe, read
+
+
+namespace {
+
+constexpr std::size_t record_ct { 64 };
+constexpr std::size_t record_sz { 64 };
+constexpr std::size_t batch_ct { 1 << 12 };
+
+}  // namespace
+
+int main() {
+    int fds[2];
+    safeLibcCall(pipe, "pipe", ret_eq<-1>{}, fds);
+    std::thread drain { [&fds]() {
+        char buf[1 << 16];
+        while (read(fds[0], buf, sizeof(buf)) > 0) {}
+    } };
+
+    std::array<std::array<char, record_sz>, record_ct> records {};
+    std::array<iovec, record_ct> iov {};
+    for (std::size_t i { 0 }; i < record_ct; ++i)
+        iov[i] = { records[i].data(), record_sz };
+
+    printResult("writeAll per record, per batch", nsPerOp([&](std::size_t n) {
+        for (std::size_t i { 0 }; i < n; ++i) {
+            for (const auto& record : records)
+                writeAll(fds[1], record.data(), record_sz);
+        }
+    }, batch_ct));
+    printResult("writevAll, per batch", nsPerOp([&](std::size_t n) {
+        for (std::size_t i { 0 }; i < n; ++i)
+            doNotOptimize(writevAll(fds[1], iov.data(), record_ct));
+    }, batch_ct));
+
+    close(fds[1]);
+    drain.join();
+    close(fds[0]);
+}
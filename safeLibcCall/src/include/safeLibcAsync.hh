@@ -0,0 +1,406 @@
+#ifndef SAFELIBCASYNC_HH
+#define SAFELIBCASYNC_HH
+
+
+#if __cplusplus < 202002L
+#error "C++20 and above required due to use of coroutines"
+#endif
+
+#include "safeLibcCall.hh"
+#include "safeLibcIo.hh"   // retry_eintr, safeLibcCallRetry
+
+#include <cerrno>         // EAGAIN, EINPROGRESS, EINTR, ENOENT, EEXIST
+#include <coroutine>
+#include <cstddef>        // size_t
+#include <cstdint>        // uint32_t
+#include <exception>      // exception_ptr, rethrow_exception
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <utility>        // exchange, move
+#include <vector>
+
+#include <sys/epoll.h>    // epoll_create1, epoll_ctl, epoll_wait
+#include <sys/socket.h>   // accept4, connect, getsockopt, recv, send
+#include <unistd.h>       // close, read, write
+
+
+/*
+ * Coroutine wrappers for calls on nonblocking fds, suspending on EAGAIN until
+ *   an epoll reactor sees the fd ready, and otherwise reporting failures as
+ *   safeLibcCall does.
+ */
+
+/*
+ * @brief Lazily started coroutine returning T, run by co_await from another
+ *   Task or by EpollReactor::spawn(); exceptions propagate to the awaiter.
+ */
+template<typename T = void>
+class Task;
+
+namespace impl {
+
+template<typename T>
+struct TaskPromiseBase {
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template<typename PromiseType>
+        std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<PromiseType> h) noexcept {
+            const std::coroutine_handle<> next { h.promise().continuation };
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void unhandled_exception() { exception = std::current_exception(); }
+
+    std::coroutine_handle<> continuation {};
+    std::exception_ptr exception {};
+};
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase<T> {
+    Task<T> get_return_object();
+    void return_value(T val) { value.emplace(std::move(val)); }
+    T result() {
+        if (this->exception)
+            std::rethrow_exception(this->exception);
+        return std::move(*value);
+    }
+
+    std::optional<T> value {};
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase<void> {
+    Task<void> get_return_object();
+    void return_void() {}
+    void result() {
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+};
+
+}  // namespace impl
+
+template<typename T>
+class Task {
+public:
+    using promise_type = impl::TaskPromise<T>;
+
+    explicit Task(const std::coroutine_handle<promise_type> handle) :
+        handle{ handle } {}
+    Task(Task&& other) noexcept : handle{ std::exchange(other.handle, {}) } {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle)
+                handle.destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    ~Task() {
+        if (handle)
+            handle.destroy();
+    }
+
+    bool done() const { return !handle || handle.done(); }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(
+                const std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            T await_resume() { return handle.promise().result(); }
+        };
+        return Awaiter{ handle };
+    }
+
+private:
+    friend class EpollReactor;
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+namespace impl {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>{ std::coroutine_handle<TaskPromise<T>>::from_promise(*this) };
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>{
+        std::coroutine_handle<TaskPromise<void>>::from_promise(*this) };
+}
+
+}  // namespace impl
+
+/*
+ * @brief Single-threaded epoll loop resuming coroutines suspended on fd
+ *   readiness, and running top-level Tasks to completion.
+ *
+ * @notes Each fd may have one coroutine awaiting readability and one awaiting
+ *   writability at a time. Registrations are one-shot, re-armed by the next
+ *   wait with a single epoll_ctl, so an fd closed while no coroutine awaits it
+ *   needs no cleanup; one closed while awaited should first be passed to
+ *   release().
+ */
+class EpollReactor {
+public:
+    EpollReactor() :
+        epoll_fd{ safeLibcCall(epoll_create1, "epoll_create1", ret_eq<-1>{},
+                               EPOLL_CLOEXEC) } {}
+
+    ~EpollReactor() {
+        // destroys any Tasks left suspended
+        tasks.clear();
+        close(epoll_fd);
+    }
+
+    EpollReactor(const EpollReactor&) = delete;
+    EpollReactor& operator=(const EpollReactor&) = delete;
+
+    /*
+     * @brief Takes ownership of `task`, to be started by run().
+     */
+    void spawn(Task<void> task) {
+        ready.push_back(task.handle);
+        tasks.push_back(std::move(task));
+    }
+
+    /*
+     * @brief Resumes coroutines as their fds become ready until all spawned
+     *   Tasks have finished, rethrowing the first exception to escape one.
+     */
+    void run() {
+        epoll_event events[max_event_ct];
+        while (!tasks.empty()) {
+            while (!ready.empty()) {
+                std::vector<std::coroutine_handle<>> resuming;
+                resuming.swap(ready);
+                for (const std::coroutine_handle<> h : resuming)
+                    h.resume();
+                reapTasks();
+            }
+            if (tasks.empty())
+                break;
+            const int event_ct { safeLibcCallRetry(
+                    retry_eintr{}, epoll_wait, "epoll_wait", ret_eq<-1>{},
+                    epoll_fd, events, max_event_ct, -1) };
+            for (int i { 0 }; i < event_ct; ++i)
+                dispatch(events[i].data.fd, events[i].events);
+        }
+    }
+
+    /*
+     * @brief Awaitable suspending until `fd` is ready for EPOLLIN (or
+     *   EPOLLOUT), or has an error or hangup for the retried call to report.
+     */
+    auto waitFor(const int fd, const std::uint32_t direction) {
+        struct Awaiter {
+            EpollReactor& reactor;
+            int fd;
+            std::uint32_t direction;
+            bool await_ready() noexcept { return false; }
+            void await_suspend(const std::coroutine_handle<> h) {
+                reactor.arm(fd, direction, h);
+            }
+            void await_resume() noexcept {}
+        };
+        return Awaiter{ *this, fd, direction };
+    }
+
+    /*
+     * @brief Stops watching `fd`, so that it may be closed while awaited;
+     *   its awaiting coroutines are never resumed.
+     */
+    void release(const int fd) {
+        if (waiters.erase(fd) != 0)
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+
+private:
+    static constexpr int max_event_ct { 64 };
+
+    struct FdWaiters {
+        std::coroutine_handle<> reader {};
+        std::coroutine_handle<> writer {};
+        bool registered { false };  // possibly disarmed, by EPOLLONESHOT
+    };
+
+    void arm(const int fd, const std::uint32_t direction,
+             const std::coroutine_handle<> h) {
+        FdWaiters& w { waiters[fd] };
+        (direction == EPOLLIN ? w.reader : w.writer) = h;
+        epoll_event event {};
+        event.events = interest(w);
+        event.data.fd = fd;
+        const int op { w.registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD };
+        const auto result { tryLibcCall(epoll_ctl, "epoll_ctl", ret_eq<-1>{},
+                                        epoll_fd, op, fd, &event) };
+        if (result) {
+            w.registered = true;
+            return;
+        }
+        // closing an fd unregisters it, and its number may since be reused
+        const int err { result.errnoValue() };
+        if ((err == ENOENT || err == EEXIST) &&
+            epoll_ctl(epoll_fd, err == ENOENT ? EPOLL_CTL_ADD : EPOLL_CTL_MOD,
+                      fd, &event) == 0) {
+            w.registered = true;
+            return;
+        }
+        (direction == EPOLLIN ? w.reader : w.writer) = {};
+        result.value();
+    }
+
+    static std::uint32_t interest(const FdWaiters& w) {
+        return (w.reader ? EPOLLIN : 0u) | (w.writer ? EPOLLOUT : 0u) |
+            EPOLLONESHOT;
+    }
+
+    void dispatch(const int fd, const std::uint32_t events) {
+        const auto it { waiters.find(fd) };
+        if (it == waiters.end())
+            return;
+        FdWaiters& w { it->second };
+        constexpr std::uint32_t failed { EPOLLERR | EPOLLHUP };
+        if (w.reader && (events & (EPOLLIN | failed)))
+            ready.push_back(std::exchange(w.reader, {}));
+        if (w.writer && (events & (EPOLLOUT | failed)))
+            ready.push_back(std::exchange(w.writer, {}));
+        // left disarmed until the next wait re-arms it, saving a syscall
+        if (!w.reader && !w.writer)
+            return;
+        epoll_event event {};
+        event.events = interest(w);
+        event.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+    }
+
+    void reapTasks() {
+        std::exception_ptr exception {};
+        for (std::size_t i { 0 }; i < tasks.size();) {
+            if (!tasks[i].done()) {
+                ++i;
+                continue;
+            }
+            if (!exception)
+                exception = tasks[i].handle.promise().exception;
+            tasks[i] = std::move(tasks.back());
+            tasks.pop_back();
+        }
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    int epoll_fd;
+    std::unordered_map<int, FdWaiters> waiters;
+    std::vector<std::coroutine_handle<>> ready;
+    std::vector<Task<void>> tasks;
+};
+
+namespace impl {
+
+/*
+ * @brief tryLibcCall with ret_eq<-1>, retried on EINTR and, after awaiting
+ *   `direction` on `fd`, on EAGAIN; failures otherwise throw as safeLibcCall.
+ */
+template<typename FuncType, typename ...ParamTypes>
+auto asyncLibcCall(EpollReactor& reactor, const int fd,
+                   const std::uint32_t direction, FuncType& libc_func,
+                   const std::string_view libc_func_name,
+                   const ParamTypes ...params) ->
+    Task<std::invoke_result_t<FuncType&, const int&, const ParamTypes&...>> {
+    for (;;) {
+        const auto result { tryLibcCall(libc_func, libc_func_name,
+                                        ret_eq<-1>{}, fd, params...) };
+        if (result)
+            co_return *result;
+        const int err { result.errnoValue() };
+        if (err == EAGAIN || err == EWOULDBLOCK)
+            co_await reactor.waitFor(fd, direction);
+        else if (err != EINTR)
+            result.value();
+    }
+}
+
+}  // namespace impl
+
+/*
+ * @brief Each as the libc call of the same name on the nonblocking `fd`,
+ *   suspending while it would block.
+ */
+inline Task<ssize_t> asyncRead(EpollReactor& reactor, const int fd,
+                               void* const buf, const std::size_t len) {
+    return impl::asyncLibcCall(reactor, fd, EPOLLIN, ::read, "read", buf, len);
+}
+
+inline Task<ssize_t> asyncWrite(EpollReactor& reactor, const int fd,
+                                const void* const buf, const std::size_t len) {
+    return impl::asyncLibcCall(reactor, fd, EPOLLOUT, ::write, "write", buf,
+                               len);
+}
+
+inline Task<ssize_t> asyncRecv(EpollReactor& reactor, const int sockfd,
+                               void* const buf, const std::size_t len,
+                               const int flags) {
+    return impl::asyncLibcCall(reactor, sockfd, EPOLLIN, ::recv, "recv", buf,
+                               len, flags);
+}
+
+inline Task<ssize_t> asyncSend(EpollReactor& reactor, const int sockfd,
+                               const void* const buf, const std::size_t len,
+                               const int flags) {
+    return impl::asyncLibcCall(reactor, sockfd, EPOLLOUT, ::send, "send", buf,
+                               len, flags);
+}
+
+/*
+ * @brief accept4 on the nonblocking listening `sockfd`, returning the
+ *   connected socket, itself nonblocking and close-on-exec.
+ */
+inline Task<int> asyncAccept(EpollReactor& reactor, const int sockfd,
+                             sockaddr* const addr = nullptr,
+                             socklen_t* const addrlen = nullptr) {
+    return impl::asyncLibcCall(reactor, sockfd, EPOLLIN, ::accept4, "accept4",
+                               addr, addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+}
+
+/*
+ * @brief connect on the nonblocking `sockfd`, completing once the socket is
+ *   writable and throwing as safeLibcCall, under the name "connect", with the
+ *   socket's SO_ERROR if the connection failed.
+ *
+ * @notes A connect interrupted by a signal (EINTR) carries on asynchronously,
+ *   as one returning EINPROGRESS does, and must not be retried (which would
+ *   fail with EALREADY), so both are awaited the same way.
+ */
+inline Task<void> asyncConnect(EpollReactor& reactor, const int sockfd,
+                               const sockaddr* const addr,
+                               const socklen_t addrlen) {
+    const auto result { tryLibcCall(::connect, "connect", ret_eq<-1>{},
+                                    sockfd, addr, addrlen) };
+    if (result)
+        co_return;
+    if (result.errnoValue() != EINPROGRESS && result.errnoValue() != EINTR)
+        result.value();
+    co_await reactor.waitFor(sockfd, EPOLLOUT);
+    int err { 0 };
+    socklen_t err_len { sizeof(err) };
+    safeLibcCall(getsockopt, "getsockopt", ret_eq<-1>{}, sockfd, SOL_SOCKET,
+                 SO_ERROR, &err, &err_len);
+    if (err != 0)
+        impl::throwLibcFailure("connect", err);
+}
+
+
+#endif  // SAFELIBCASYNC_HH
@@ -0,0 +1,507 @@
+#ifndef SAFELIBCBATCH_HH
+#define SAFELIBCBATCH_HH
+
+
+#include "safeLibcCall.hh"
+#include "safeLibcPool.hh"  // impl::WorkerThreads
+
+#include <algorithm>     // max, min
+#include <atomic>
+#include <cstddef>       // size_t
+#include <cstdint>       // uint64_t, uintptr_t
+#include <cstring>       // memset
+#include <functional>
+#include <memory>        // unique_ptr
+#include <stdexcept>     // invalid_argument
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>       // openat
+#include <sys/stat.h>    // statx
+#include <sys/types.h>   // mode_t, off_t, ssize_t
+#include <unistd.h>      // close, fsync, pread, pwrite, read, write
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>     // mmap, munmap
+#include <sys/syscall.h>  // SYS_io_uring_setup, SYS_io_uring_enter
+#if defined(SYS_io_uring_setup) && defined(SYS_io_uring_enter)
+#define SAFELIBCCALL_HAS_IO_URING 1
+#endif
+#endif
+
+
+/*
+ * Batches of file operations submitted together, through io_uring where the
+ *   kernel offers it and otherwise by a pool of threads making the libc calls,
+ *   each operation's outcome reported as a LibcResult as by tryLibcCall.
+ */
+
+enum class LibcBatchBackend { Auto, IoUring, ThreadPool };
+
+namespace impl {
+
+enum class BatchOpKind : unsigned char {
+    Openat, Read, Write, Statx, Close, Fsync
+};
+
+struct BatchOp {
+    BatchOpKind kind;
+    int fd;                    // dirfd for Openat and Statx
+    const char* path;
+    void* buf;                 // struct statx* for Statx
+    unsigned len;              // mode for Openat, mask for Statx
+    int flags;
+    std::uint64_t offset;      // -1 for the file position
+};
+
+constexpr std::string_view batchOpName(const BatchOpKind kind) {
+    switch (kind) {
+    case BatchOpKind::Openat: return "openat";
+    case BatchOpKind::Read:   return "read";
+    case BatchOpKind::Write:  return "write";
+    case BatchOpKind::Statx:  return "statx";
+    case BatchOpKind::Close:  return "close";
+    case BatchOpKind::Fsync:  return "fsync";
+    }
+    return "";
+}
+
+constexpr std::uint64_t batch_cur_pos { ~std::uint64_t{ 0 } };
+
+/*
+ * @brief The operation by its libc call, in the calling thread.
+ */
+inline LibcResult<ssize_t> runBatchOp(const BatchOp& op) {
+    const std::string_view name { batchOpName(op.kind) };
+    switch (op.kind) {
+    case BatchOpKind::Openat:
+        return tryLibcCall(::openat, name, ret_eq<-1>{}, op.fd, op.path,
+                           op.flags, static_cast<mode_t>(op.len));
+    case BatchOpKind::Read:
+        if (op.offset == batch_cur_pos)
+            return tryLibcCall(::read, name, ret_eq<-1>{}, op.fd, op.buf,
+                               op.len);
+        return tryLibcCall(::pread, name, ret_eq<-1>{}, op.fd, op.buf, op.len,
+                           static_cast<off_t>(op.offset));
+    case BatchOpKind::Write:
+        if (op.offset == batch_cur_pos)
+            return tryLibcCall(::write, name, ret_eq<-1>{}, op.fd, op.buf,
+                               op.len);
+        return tryLibcCall(::pwrite, name, ret_eq<-1>{}, op.fd, op.buf, op.len,
+                           static_cast<off_t>(op.offset));
+    case BatchOpKind::Statx:
+        return tryLibcCall(::statx, name, ret_eq<-1>{}, op.fd, op.path,
+                           op.flags, op.len, static_cast<struct statx*>(op.buf));
+    case BatchOpKind::Close:
+        return tryLibcCall(::close, name, ret_eq<-1>{}, op.fd);
+    case BatchOpKind::Fsync:
+        return tryLibcCall(::fsync, name, ret_eq<-1>{}, op.fd);
+    }
+    return { -1, EINVAL, true, name };
+}
+
+/*
+ * @brief Worker threads running the indices of a task in parallel, taking
+ *   them one at a time from a shared counter, the calling thread joining in.
+ */
+class BatchThreadPool {
+public:
+    explicit BatchThreadPool(const unsigned thread_ct) : workers { thread_ct } {}
+
+    /*
+     * @brief Calls `task(i)` for each i in [0, task_ct), returning when all
+     *   calls have.
+     */
+    void run(const std::size_t task_ct,
+             const std::function<void(std::size_t)>& task) {
+        next.store(0, std::memory_order_relaxed);
+        workers.run([this, &task, task_ct](std::size_t) {
+            for (std::size_t i { next.fetch_add(1, std::memory_order_relaxed) };
+                 i < task_ct; i = next.fetch_add(1, std::memory_order_relaxed))
+                task(i);
+        });
+    }
+
+private:
+    std::atomic<std::size_t> next { 0 };
+    WorkerThreads workers;  // last, so its threads stop first
+};
+
+#ifdef SAFELIBCCALL_HAS_IO_URING
+
+/*
+ * @brief Minimal io_uring instance by raw system calls (no liburing), with
+ *   the submission and completion rings mapped into this process.
+ */
+class IoUring {
+public:
+    /*
+     * @brief Sets up a ring of `entries` submission slots, or leaves
+     *   valid() false where the kernel lacks io_uring (before Linux 5.6, for
+     *   the operations used here) or forbids it (eg seccomp, or
+     *   kernel.io_uring_disabled).
+     */
+    explicit IoUring(const unsigned entries) {
+        io_uring_params params {};
+        const long fd { syscall(SYS_io_uring_setup, entries, &params) };
+        if (fd < 0)
+            return;
+        ring_fd = static_cast<int>(fd);
+        // IORING_FEAT_RW_CUR_POS arrived with the openat, statx, close, read
+        //   and write opcodes in 5.6
+        if (!(params.features & IORING_FEAT_RW_CUR_POS) || !map(params)) {
+            unmap();
+            return;
+        }
+        sq_entries = params.sq_entries;
+    }
+
+    ~IoUring() { unmap(); }
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    bool valid() const { return sq_entries != 0; }
+
+    /*
+     * @brief Runs `ops`, storing each outcome at the same index in `results`,
+     *   in rounds of up to the ring's size.
+     *
+     * @notes io_uring_enter is retried on EINTR, and on EAGAIN and EBUSY
+     *   (kernel resources or completion queue space short for now) once
+     *   completions have been reaped. Other failures of io_uring_enter throw
+     *   as safeLibcCall, but only once every operation already submitted has
+     *   completed, so that none is left writing into the caller's buffers.
+     */
+    void run(const std::vector<BatchOp>& ops,
+             std::vector<LibcResult<ssize_t>>& results) {
+        for (std::size_t first { 0 }; first < ops.size(); first += sq_entries) {
+            const unsigned ct { static_cast<unsigned>(std::min<std::size_t>(
+                        sq_entries, ops.size() - first)) };
+            unsigned tail { *sq_tail };
+            for (unsigned i { 0 }; i < ct; ++i, ++tail) {
+                const unsigned slot { tail & *sq_mask };
+                fillSqe(sqes[slot], ops[first + i], first + i);
+                sq_array[slot] = slot;
+            }
+            __atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+            unsigned to_submit { ct };
+            for (unsigned reaped { 0 }; reaped < ct;) {
+                const long submitted { syscall(SYS_io_uring_enter, ring_fd,
+                                               to_submit, ct - reaped,
+                                               IORING_ENTER_GETEVENTS, nullptr,
+                                               0) };
+                if (submitted >= 0) {
+                    to_submit -= static_cast<unsigned>(submitted);
+                } else if (const int err { errno };
+                           err != EINTR && err != EAGAIN && err != EBUSY) {
+                    reaped += reap(ops, results);
+                    abandon(ops, results, ct - to_submit - reaped);
+                    impl::throwLibcFailure("io_uring_enter", err);
+                }
+                reaped += reap(ops, results);
+            }
+        }
+    }
+
+private:
+    bool map(const io_uring_params& params) {
+        sq_ring_sz = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_sz = params.cq_off.cqes +
+            params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap { (params.features & IORING_FEAT_SINGLE_MMAP) != 0 };
+        if (single_mmap)
+            sq_ring_sz = cq_ring_sz = std::max(sq_ring_sz, cq_ring_sz);
+        sq_ring = mapRegion(sq_ring_sz, IORING_OFF_SQ_RING);
+        if (sq_ring == nullptr)
+            return false;
+        cq_ring = single_mmap ? sq_ring :
+            mapRegion(cq_ring_sz, IORING_OFF_CQ_RING);
+        if (cq_ring == nullptr)
+            return false;
+        sqes_sz = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(mapRegion(sqes_sz, IORING_OFF_SQES));
+        if (sqes == nullptr)
+            return false;
+
+        char* const sq { static_cast<char*>(sq_ring) };
+        sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        char* const cq { static_cast<char*>(cq_ring) };
+        cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    void* mapRegion(const std::size_t sz, const off_t offset) {
+        void* const addr { mmap(nullptr, sz, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_POPULATE, ring_fd, offset) };
+        return addr == MAP_FAILED ? nullptr : addr;
+    }
+
+    void unmap() {
+        if (sqes != nullptr)
+            munmap(sqes, sqes_sz);
+        if (cq_ring != nullptr && cq_ring != sq_ring)
+            munmap(cq_ring, cq_ring_sz);
+        if (sq_ring != nullptr)
+            munmap(sq_ring, sq_ring_sz);
+        if (ring_fd >= 0)
+            ::close(ring_fd);
+        sqes = nullptr;
+        cq_ring = sq_ring = nullptr;
+        ring_fd = -1;
+        sq_entries = 0;
+    }
+
+    static void fillSqe(io_uring_sqe& sqe, const BatchOp& op,
+                        const std::size_t index) {
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.fd = op.fd;
+        sqe.user_data = index;
+        switch (op.kind) {
+        case BatchOpKind::Openat:
+            sqe.opcode = IORING_OP_OPENAT;
+            sqe.addr = addrOf(op.path);
+            sqe.len = op.len;
+            sqe.open_flags = static_cast<std::uint32_t>(op.flags);
+            break;
+        case BatchOpKind::Read:
+        case BatchOpKind::Write:
+            sqe.opcode = op.kind == BatchOpKind::Read ?
+                IORING_OP_READ : IORING_OP_WRITE;
+            sqe.addr = addrOf(op.buf);
+            sqe.len = op.len;
+            sqe.off = op.offset;
+            break;
+        case BatchOpKind::Statx:
+            sqe.opcode = IORING_OP_STATX;
+            sqe.addr = addrOf(op.path);
+            sqe.len = op.len;
+            sqe.off = addrOf(op.buf);
+            sqe.statx_flags = static_cast<std::uint32_t>(op.flags);
+            break;
+        case BatchOpKind::Close:
+            sqe.opcode = IORING_OP_CLOSE;
+            break;
+        case BatchOpKind::Fsync:
+            sqe.opcode = IORING_OP_FSYNC;
+            break;
+        }
+    }
+
+    static std::uint64_t addrOf(const void* const ptr) {
+        return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr));
+    }
+
+    /*
+     * @brief Withdraws the submission entries the kernel has not taken, and
+     *   waits for the `in_flight` operations it has to complete.
+     */
+    void abandon(const std::vector<BatchOp>& ops,
+                 std::vector<LibcResult<ssize_t>>& results,
+                 unsigned in_flight) {
+        __atomic_store_n(sq_tail, __atomic_load_n(sq_head, __ATOMIC_ACQUIRE),
+                         __ATOMIC_RELEASE);
+        while (in_flight > 0) {
+            const unsigned ct { reap(ops, results) };
+            in_flight -= std::min(ct, in_flight);
+            // failures only mean polling again; returning from any system
+            //   call also runs the kernel work that posts completions
+            if (in_flight > 0 && ct == 0)
+                syscall(SYS_io_uring_enter, ring_fd, 0, in_flight,
+                        IORING_ENTER_GETEVENTS, nullptr, 0);
+        }
+    }
+
+    // completions carry the syscall's return value, or -errno on failure;
+    //   any not from `ops` (which should not occur) are discarded uncounted
+    unsigned reap(const std::vector<BatchOp>& ops,
+                  std::vector<LibcResult<ssize_t>>& results) {
+        unsigned head { *cq_head };
+        const unsigned tail { __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE) };
+        unsigned ct { 0 };
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe { cqes[head & *cq_mask] };
+            if (cqe.user_data >= ops.size())
+                continue;
+            ++ct;
+            const std::size_t i { static_cast<std::size_t>(cqe.user_data) };
+            const std::string_view name { batchOpName(ops[i].kind) };
+            results[i] = cqe.res < 0 ?
+                LibcResult<ssize_t>{ -1, -cqe.res, true, name } :
+                LibcResult<ssize_t>{ cqe.res, 0, false, name };
+        }
+        __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+        return ct;
+    }
+
+    int ring_fd { -1 };
+    unsigned sq_entries { 0 };
+    void* sq_ring { nullptr };
+    void* cq_ring { nullptr };
+    std::size_t sq_ring_sz { 0 };
+    std::size_t cq_ring_sz { 0 };
+    io_uring_sqe* sqes { nullptr };
+    std::size_t sqes_sz { 0 };
+    unsigned* sq_head { nullptr };
+    unsigned* sq_tail { nullptr };
+    unsigned* sq_mask { nullptr };
+    unsigned* sq_array { nullptr };
+    unsigned* cq_head { nullptr };
+    unsigned* cq_tail { nullptr };
+    unsigned* cq_mask { nullptr };
+    io_uring_cqe* cqes { nullptr };
+};
+
+#endif  // SAFELIBCCALL_HAS_IO_URING
+
+}  // namespace impl
+
+/*
+ * @brief Queue of file operations run together by submit(), which returns
+ *   each one's outcome as tryLibcCall would have for the equivalent libc
+ *   call: a failure sets the result's errno and never stops the rest of the
+ *   batch, and result.value() throws what safeLibcCall would have.
+ *
+ * @notes Operations within a batch run concurrently in no particular order,
+ *   so one depending on another (eg reading from an fd opened in the same
+ *   batch) must go in a later batch. Paths and buffers must stay valid until
+ *   submit() returns.
+ *   With io_uring each round of up to `queue_depth` operations costs one
+ *   system call, rather than one per operation. The thread pool fallback
+ *   makes the libc calls on `thread_ct` threads (including the caller), by
+ *   default one per core, and at least 2.
+ */
+class LibcBatch {
+public:
+    using Result = LibcResult<ssize_t>;
+
+    /*
+     * @brief Uses io_uring if `backend` is Auto or IoUring and the kernel
+     *   allows it, else the thread pool; throws std::invalid_argument if
+     *   IoUring was required but is unavailable.
+     */
+    explicit LibcBatch(const unsigned queue_depth = 64,
+                       const LibcBatchBackend backend = LibcBatchBackend::Auto,
+                       const unsigned thread_ct = 0) {
+#ifdef SAFELIBCCALL_HAS_IO_URING
+        if (backend != LibcBatchBackend::ThreadPool) {
+            ring = std::make_unique<impl::IoUring>(queue_depth);
+            if (!ring->valid())
+                ring.reset();
+        }
+#else
+        static_cast<void>(queue_depth);
+#endif
+        if (backend == LibcBatchBackend::IoUring && !usingIoUring())
+            throw std::invalid_argument("LibcBatch: io_uring unavailable");
+        if (!usingIoUring()) {
+            pool = std::make_unique<impl::BatchThreadPool>(
+                thread_ct != 0 ? thread_ct :
+                std::max(2u, std::thread::hardware_concurrency()));
+        }
+    }
+
+    LibcBatchBackend backend() const {
+        return usingIoUring() ? LibcBatchBackend::IoUring :
+            LibcBatchBackend::ThreadPool;
+    }
+
+    /*
+     * @brief Each queues an operation with the arguments of the libc call of
+     *   the same name, returning its index in the results of submit().
+     */
+    std::size_t openat(const int dirfd, const char* const path,
+                       const int flags, const mode_t mode = 0) {
+        return queue({ impl::BatchOpKind::Openat, dirfd, path, nullptr,
+                       static_cast<unsigned>(mode), flags, 0 });
+    }
+
+    // `offset` as for pread, or -1 for the file position (as for read)
+    std::size_t read(const int fd, void* const buf, const unsigned len,
+                     const off_t offset = -1) {
+        return queue({ impl::BatchOpKind::Read, fd, nullptr, buf, len, 0,
+                       static_cast<std::uint64_t>(offset) });
+    }
+
+    // `offset` as for pwrite, or -1 for the file position (as for write)
+    std::size_t write(const int fd, const void* const buf, const unsigned len,
+                      const off_t offset = -1) {
+        return queue({ impl::BatchOpKind::Write, fd, nullptr,
+                       const_cast<void*>(buf), len, 0,
+                       static_cast<std::uint64_t>(offset) });
+    }
+
+    // as statx(2): `path` relative to `dirfd` (or AT_FDCWD), `flags` eg
+    //   AT_SYMLINK_NOFOLLOW, or AT_EMPTY_PATH with path "" to stat dirfd itself
+    std::size_t statx(const int dirfd, const char* const path,
+                      const int flags, const unsigned mask,
+                      struct statx* const statxbuf) {
+        return queue({ impl::BatchOpKind::Statx, dirfd, path, statxbuf, mask,
+                       flags, 0 });
+    }
+
+    std::size_t close(const int fd) {
+        return queue({ impl::BatchOpKind::Close, fd, nullptr, nullptr, 0, 0,
+                       0 });
+    }
+
+    std::size_t fsync(const int fd) {
+        return queue({ impl::BatchOpKind::Fsync, fd, nullptr, nullptr, 0, 0,
+                       0 });
+    }
+
+    std::size_t size() const { return ops.size(); }
+
+    /*
+     * @brief Runs all queued operations and empties the queue, returning
+     *   their outcomes in the order queued.
+     */
+    std::vector<Result> submit() {
+        std::vector<Result> results;
+        results.reserve(ops.size());
+        for (const impl::BatchOp& op : ops)
+            results.emplace_back(-1, 0, true, impl::batchOpName(op.kind));
+#ifdef SAFELIBCCALL_HAS_IO_URING
+        if (ring)
+            ring->run(ops, results);
+#endif
+        if (pool) {
+            pool->run(ops.size(), [this, &results](const std::size_t i) {
+                results[i] = impl::runBatchOp(ops[i]);
+            });
+        }
+        ops.clear();
+        return results;
+    }
+
+private:
+    bool usingIoUring() const {
+#ifdef SAFELIBCCALL_HAS_IO_URING
+        return ring != nullptr;
+#else
+        return false;
+#endif
+    }
+
+    std::size_t queue(const impl::BatchOp& op) {
+        ops.push_back(op);
+        return ops.size() - 1;
+    }
+
+    std::vector<impl::BatchOp> ops;
+#ifdef SAFELIBCCALL_HAS_IO_URING
+    std::unique_ptr<impl::IoUring> ring;
+#endif
+    std::unique_ptr<impl::BatchThreadPool> pool;
+};
+
+
+#endif  // SAFELIBCBATCH_HH
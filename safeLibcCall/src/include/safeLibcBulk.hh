@@ -0,0 +1,279 @@
+#ifndef SAFELIBCBULK_HH
+#define SAFELIBCBULK_HH
+
+
+#include "safeLibcCall.hh"
+#include "safeLibcPool.hh"  // impl::WorkerThreads
+
+#include <algorithm>     // max, min
+#include <cstddef>       // ptrdiff_t, size_t
+#include <exception>     // exception_ptr, rethrow_exception
+#include <functional>
+#include <iterator>      // begin, next, size
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <tuple>         // apply, tuple_size
+#include <type_traits>
+#include <utility>       // exchange, forward
+#include <vector>
+
+
+/*
+ * The same libc call over many argument sets, run in parallel with failures
+ *   collected per element rather than thrown.
+ */
+
+/*
+ * @brief Persistent threads running loops of independent iterations, each
+ *   thread taking chunks from its own share of the indices, and once that is
+ *   exhausted stealing the back half of another thread's remaining share.
+ *
+ * @notes Stealing keeps threads busy when iterations vary in cost, as
+ *   syscalls on a filesystem do, without the contention of all threads
+ *   taking chunks from one shared counter.
+ */
+class LibcWorkPool {
+public:
+    /*
+     * @brief Runs loops on `thread_ct` threads including the caller, by
+     *   default one per core.
+     */
+    explicit LibcWorkPool(const unsigned thread_ct = 0) :
+        shares(std::max(1u, thread_ct != 0 ? thread_ct :
+                        std::thread::hardware_concurrency())),
+        workers { static_cast<unsigned>(shares.size()) } {}
+
+    LibcWorkPool(const LibcWorkPool&) = delete;
+    LibcWorkPool& operator=(const LibcWorkPool&) = delete;
+
+    unsigned threadCount() const { return static_cast<unsigned>(shares.size()); }
+
+    /*
+     * @brief Calls `body(i)` for each i in [0, n), in chunks of up to `grain`
+     *   iterations, returning when all have completed; rethrows the first
+     *   exception thrown by `body`, after the rest of the loop has run.
+     */
+    void parallelFor(const std::size_t n,
+                     const std::function<void(std::size_t)>& body,
+                     const std::size_t grain = 16) {
+        const std::size_t share_ct { shares.size() };
+        for (std::size_t w { 0 }; w < share_ct; ++w) {
+            const std::lock_guard<std::mutex> share_lock { shares[w].mtx };
+            shares[w].begin = n * w / share_ct;
+            shares[w].end = n * (w + 1) / share_ct;
+        }
+        exception = nullptr;
+        const std::size_t chunk { std::max<std::size_t>(1, grain) };
+        workers.run([this, &body, chunk](const std::size_t w) {
+            drain(w, body, chunk);
+        });
+        if (exception)
+            std::rethrow_exception(std::exchange(exception, nullptr));
+    }
+
+private:
+    struct alignas(64) Share {
+        std::mutex mtx;
+        std::size_t begin { 0 };
+        std::size_t end { 0 };
+    };
+
+    bool takeChunk(const std::size_t w, const std::size_t grain,
+                   std::size_t& first, std::size_t& last) {
+        Share& own { shares[w] };
+        const std::lock_guard<std::mutex> lock { own.mtx };
+        if (own.begin == own.end)
+            return false;
+        first = own.begin;
+        last = std::min(own.end, own.begin + grain);
+        own.begin = last;
+        return true;
+    }
+
+    // moves the back half of the fullest other share into share w
+    bool steal(const std::size_t w) {
+        std::size_t victim { w };
+        std::size_t most { 0 };
+        for (std::size_t v { 0 }; v < shares.size(); ++v) {
+            if (v == w)
+                continue;
+            const std::lock_guard<std::mutex> lock { shares[v].mtx };
+            if (shares[v].end - shares[v].begin > most) {
+                most = shares[v].end - shares[v].begin;
+                victim = v;
+            }
+        }
+        if (victim == w)
+            return false;
+        std::size_t first, last;
+        {
+            Share& from { shares[victim] };
+            const std::lock_guard<std::mutex> lock { from.mtx };
+            const std::size_t left { from.end - from.begin };
+            if (left == 0)
+                return true;  // emptied meanwhile; look again
+            last = from.end;
+            first = from.end - (left + 1) / 2;
+            from.end = first;
+        }
+        const std::lock_guard<std::mutex> lock { shares[w].mtx };
+        shares[w].begin = first;
+        shares[w].end = last;
+        return true;
+    }
+
+    void drain(const std::size_t w,
+               const std::function<void(std::size_t)>& body,
+               const std::size_t grain) {
+        for (;;) {
+            std::size_t first, last;
+            if (!takeChunk(w, grain, first, last)) {
+                if (!steal(w))
+                    return;
+                continue;
+            }
+            try {
+                for (std::size_t i { first }; i < last; ++i)
+                    body(i);
+            } catch (...) {
+                const std::lock_guard<std::mutex> lock { exception_mtx };
+                if (!exception)
+                    exception = std::current_exception();
+            }
+        }
+    }
+
+    std::vector<Share> shares;  // one per thread, the caller's first
+    std::mutex exception_mtx;
+    std::exception_ptr exception {};
+    impl::WorkerThreads workers;  // last, so its threads stop first
+};
+
+namespace impl {
+
+template<typename T, typename = void>
+struct is_tuple_like : std::false_type {};
+
+template<typename T>
+struct is_tuple_like<T, std::void_t<decltype(std::tuple_size<T>::value)>> :
+        std::true_type {};
+
+/*
+ * @brief `func` called with the elements of `args` if a tuple (or pair or
+ *   array), else with `args` itself.
+ */
+template<typename FuncType, typename ArgsType>
+decltype(auto) applyArgs(FuncType& func, const ArgsType& args) {
+    if constexpr (is_tuple_like<ArgsType>::value)
+        return std::apply(func, args);
+    else
+        return func(args);
+}
+
+template<typename FuncType, typename RangeType>
+using bulk_return_t = std::decay_t<decltype(applyArgs(
+        std::declval<FuncType&>(),
+        *std::begin(std::declval<const RangeType&>())))>;
+
+}  // namespace impl
+
+/*
+ * @brief Per-element outcomes of bulkLibcCall, in the order of its argument
+ *   range, with failures also counted by errno.
+ */
+template<typename ReturnType>
+class LibcBulkResult {
+public:
+    explicit LibcBulkResult(std::vector<LibcResult<ReturnType>> results) :
+        results{ std::move(results) } {
+        for (const LibcResult<ReturnType>& result : this->results) {
+            if (!result)
+                ++errno_cts[result.errnoValue()];
+        }
+    }
+
+    const std::vector<LibcResult<ReturnType>>& operator*() const {
+        return results;
+    }
+    const LibcResult<ReturnType>& operator[](const std::size_t i) const {
+        return results[i];
+    }
+    std::size_t size() const { return results.size(); }
+
+    std::size_t failureCount() const {
+        std::size_t ct { 0 };
+        for (const auto& [err, err_ct] : errno_cts)
+            ct += err_ct;
+        return ct;
+    }
+
+    // failures by errno, 0 for those that left errno unset
+    const std::map<int, std::size_t>& errnoCounts() const { return errno_cts; }
+
+    /*
+     * @brief Throws for the first failure, in range order, what safeLibcCall
+     *   would have thrown for it.
+     */
+    void throwIfFailed() const {
+        for (const LibcResult<ReturnType>& result : results)
+            result.value();
+    }
+
+private:
+    std::vector<LibcResult<ReturnType>> results;
+    std::map<int, std::size_t> errno_cts;
+};
+
+/*
+ * @brief tryLibcCall(libc_func, libc_func_name, is_failure, args...) for each
+ *   element of `arg_range`, which may be tuples (or pairs) of arguments, or
+ *   single arguments; calls run in parallel on `pool`, and every call is made
+ *   whatever others return.
+ *
+ * @notes As calls run concurrently, they must not depend on each other;
+ *   errno is thread-local, so each result's errno is its own. Elements are
+ *   reached with std::next, so a random-access range avoids a walk per call.
+ */
+template<typename FuncType, typename PredType, typename RangeType>
+auto bulkLibcCall(LibcWorkPool& pool, FuncType&& libc_func,
+                  const std::string_view libc_func_name,
+                  const PredType is_failure, const RangeType& arg_range) ->
+    std::enable_if_t<impl::is_libc_predicate_v<PredType>,
+                     LibcBulkResult<impl::bulk_return_t<FuncType, RangeType>>>
+{
+    using ReturnType = impl::bulk_return_t<FuncType, RangeType>;
+    const std::size_t n { static_cast<std::size_t>(std::size(arg_range)) };
+    const auto first { std::begin(arg_range) };
+    std::vector<LibcResult<ReturnType>> results(
+        n, LibcResult<ReturnType>{ ReturnType{}, 0, false, libc_func_name });
+    pool.parallelFor(n, [&](const std::size_t i) {
+        const auto& args { *std::next(first, static_cast<std::ptrdiff_t>(i)) };
+        auto call { [&](auto&& ...params) {
+            return tryLibcCall(libc_func, libc_func_name, is_failure,
+                               std::forward<decltype(params)>(params)...);
+        } };
+        results[i] = impl::applyArgs(call, args);
+    });
+    return LibcBulkResult<ReturnType>{ std::move(results) };
+}
+
+/*
+ * @brief As above, on a pool of `thread_ct` threads (by default one per core)
+ *   made for this call.
+ */
+template<typename FuncType, typename PredType, typename RangeType>
+auto bulkLibcCall(FuncType&& libc_func, const std::string_view libc_func_name,
+                  const PredType is_failure, const RangeType& arg_range,
+                  const unsigned thread_ct = 0) ->
+    std::enable_if_t<impl::is_libc_predicate_v<PredType>,
+                     LibcBulkResult<impl::bulk_return_t<FuncType, RangeType>>>
+{
+    LibcWorkPool pool { thread_ct };
+    return bulkLibcCall(pool, std::forward<FuncType>(libc_func),
+                        libc_func_name, is_failure, arg_range);
+}
+
+
+#endif  // SAFELIBCBULK_HH
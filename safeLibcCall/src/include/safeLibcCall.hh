@@ -2,12 +2,33 @@
 #define SAFELIBCCALL_HH
 
 
+#include "safeLibcError.hh"  // LibcError, impl::libcErrnoCode, impl::throwLibcFailure
+
+#include <cerrno>
+#include <cstddef>       // nullptr_t, size_t
 #include <functional>
-#include <stdexcept>     // runtime_error
 #include <string_view>
-#include <sstream>
-#include <system_error>  // error_condition, system_category
+#include <system_error>  // error_code
 #include <type_traits>   // invoke_result_t
+#include <utility>       // forward
+#if __cplusplus >= 202002L
+#include <source_location>
+#endif
+
+/*
+ * Opt-in per-function call statistics (see safeLibcStats.hh); otherwise the
+ *   recording macros expand to nothing.
+ */
+#ifdef SAFELIBCCALL_INSTRUMENT
+#include "safeLibcStats.hh"
+#define SAFELIBCCALL_STATS_BEGIN() \
+    const std::uint64_t safelibccall_start_ticks { impl::statsTicks() }
+#define SAFELIBCCALL_STATS_END(libc_func_name, failed) \
+    impl::recordLibcCall(libc_func_name, safelibccall_start_ticks, failed)
+#else
+#define SAFELIBCCALL_STATS_BEGIN() static_cast<void>(0)
+#define SAFELIBCCALL_STATS_END(libc_func_name, failed) static_cast<void>(0)
+#endif
 
 
 /*
@@ -35,21 +56,13 @@ ReturnType safeLibcCall(const FuncType&& libc_func,
                         const LibcRetErrTest<ReturnType>& is_failure,
                         ParamTypes ...params)
 {
+    SAFELIBCCALL_STATS_BEGIN();
     errno = 0;
     ReturnType retval { libc_func(params...) };
-    if (is_failure(retval, errno)) {
-        std::ostringstream msg;
-        msg << libc_func_name;
-        if (errno == 0) {
-            msg << ": failure without setting errno";
-            throw std::runtime_error(msg.str());
-        } else {
-            const std::error_condition econd {
-                std::system_category().default_error_condition(errno) };
-            throw std::system_error(econd.value(), econd.category(),
-                                    msg.str());
-        }
-    }
+    const bool failed { is_failure(retval, errno) };
+    SAFELIBCCALL_STATS_END(libc_func_name, failed);
+    if (failed)
+        impl::throwLibcFailure(libc_func_name, errno);
     return retval;
 }
 
@@ -59,21 +72,13 @@ ReturnType safeLibcCall(const FuncType&& libc_func,
                         const LibcRetTest<ReturnType>& is_failure,
                         ParamTypes ...params)
 {
+    SAFELIBCCALL_STATS_BEGIN();
     errno = 0;
     ReturnType retval { libc_func(params...) };
-    if (is_failure(retval)) {
-        std::ostringstream msg;
-        msg << libc_func_name;
-        if (errno == 0) {
-            msg << ": failure without setting errno";
-            throw std::runtime_error(msg.str());
-        } else {
-            const std::error_condition econd {
-                std::system_category().default_error_condition(errno) };
-            throw std::system_error(econd.value(), econd.category(),
-                                    msg.str());
-        }
-    }
+    const bool failed { is_failure(retval) };
+    SAFELIBCCALL_STATS_END(libc_func_name, failed);
+    if (failed)
+        impl::throwLibcFailure(libc_func_name, errno);
     return retval;
 }
 
@@ -84,21 +89,13 @@ auto safeLibcCall(const FuncType&& libc_func,
                   ParamTypes ...params) ->
     std::invoke_result_t<FuncType, ParamTypes...>
 {
+    SAFELIBCCALL_STATS_BEGIN();
     errno = 0;
     auto retval { libc_func(params...) };
-    if (is_failure(errno)) {
-        std::ostringstream msg;
-        msg << libc_func_name;
-        if (errno == 0) {
-            msg << ": failure without setting errno";
-            throw std::runtime_error(msg.str());
-        } else {
-            const std::error_condition econd {
-                std::system_category().default_error_condition(errno) };
-            throw std::system_error(econd.value(), econd.category(),
-                                    msg.str());
-        }
-    }
+    const bool failed { is_failure(errno) };
+    SAFELIBCCALL_STATS_END(libc_func_name, failed);
+    if (failed)
+        impl::throwLibcFailure(libc_func_name, errno);
     return retval;
 }
 
@@ -108,15 +105,435 @@ auto safeLibcCall(const FuncType&& libc_func,
                   ParamTypes ...params) ->
     std::invoke_result_t<FuncType, ParamTypes...>
 {
+    SAFELIBCCALL_STATS_BEGIN();
     errno = 0;
     auto retval { libc_func(params...) };
-    if (errno != 0) {
-        const std::error_condition econd {
-            std::system_category().default_error_condition(errno) };
-        throw std::system_error(econd.value(), econd.category(),
-                                libc_func_name.data());
+    SAFELIBCCALL_STATS_END(libc_func_name, errno != 0);
+    if (errno != 0)
+        impl::throwLibcFailure(libc_func_name, errno);
+    return retval;
+}
+
+/*
+ * Compile-time failure predicates: any callable, taken by value and called
+ *   directly, so that with a stateless predicate the success path inlines to
+ *   the libc call, the errno reset and one compare. Each predicate type
+ *   declares in `kind` which of (return value, errno) it tests, serving the
+ *   same purpose as the distinct std::function types above.
+ */
+enum class LibcTestKind { Ret, Err, RetErr };
+
+/*
+ * @brief Fails when the return value equals FailVal, eg `ret_eq<-1>` for most
+ *   POSIX calls.
+ */
+template<auto FailVal>
+struct ret_eq {
+    static constexpr LibcTestKind kind { LibcTestKind::Ret };
+    template<typename ReturnType>
+    constexpr bool operator()(const ReturnType& ret) const {
+        return ret == FailVal;
+    }
+};
+
+/*
+ * @brief Fails when a pointer return value is null, eg for fopen or malloc.
+ */
+struct ret_null {
+    static constexpr LibcTestKind kind { LibcTestKind::Ret };
+    template<typename ReturnType>
+    constexpr bool operator()(const ReturnType& ret) const {
+        return ret == nullptr;
+    }
+};
+
+/*
+ * @brief Fails when errno is set, whatever the return value.
+ */
+struct errno_nonzero {
+    static constexpr LibcTestKind kind { LibcTestKind::Err };
+    constexpr bool operator()(const int err) const { return err != 0; }
+};
+
+/*
+ * @brief Marks a callable as testing the return value, errno, or both; eg
+ *   `retTest([](const ssize_t ret) { return ret < 0; })`.
+ */
+template<typename PredType, LibcTestKind Kind>
+struct LibcPredicate {
+    static constexpr LibcTestKind kind { Kind };
+    PredType pred;
+
+    template<typename ...ArgTypes>
+    constexpr bool operator()(const ArgTypes& ...args) const {
+        return pred(args...);
+    }
+};
+
+template<typename PredType>
+constexpr LibcPredicate<PredType, LibcTestKind::Ret> retTest(PredType pred) {
+    return { pred };
+}
+
+template<typename PredType>
+constexpr LibcPredicate<PredType, LibcTestKind::Err> errTest(PredType pred) {
+    return { pred };
+}
+
+template<typename PredType>
+constexpr LibcPredicate<PredType, LibcTestKind::RetErr> retErrTest(PredType pred) {
+    return { pred };
+}
+
+namespace impl {
+
+template<typename PredType, typename = void>
+struct is_libc_predicate : std::false_type {};
+
+template<typename PredType>
+struct is_libc_predicate<PredType, std::void_t<decltype(PredType::kind)>> :
+        std::is_same<std::remove_cv_t<decltype(PredType::kind)>, LibcTestKind> {};
+
+template<typename PredType>
+inline constexpr bool is_libc_predicate_v { is_libc_predicate<PredType>::value };
+
+template<typename PredType, typename ReturnType>
+constexpr bool libcCallFailed(const PredType& is_failure,
+                              const ReturnType& retval) {
+    if constexpr (PredType::kind == LibcTestKind::Ret)
+        return is_failure(retval);
+    else if constexpr (PredType::kind == LibcTestKind::Err)
+        return is_failure(errno);
+    else
+        return is_failure(retval, errno);
+}
+
+}  // namespace impl
+
+#if __cplusplus >= 202002L
+template<typename PredType>
+concept LibcFailurePredicate = impl::is_libc_predicate_v<PredType>;
+#endif
+
+/*
+ * @brief As the overloads above, but with `is_failure` any predicate type
+ *   declaring its `kind`, such as ret_eq, ret_null, errno_nonzero or the
+ *   results of retTest, errTest and retErrTest, and with `params` forwarded
+ *   rather than copied.
+ */
+template<typename FuncType, typename PredType, typename ...ParamTypes>
+auto safeLibcCall(FuncType&& libc_func,
+                  const std::string_view libc_func_name,
+                  const PredType is_failure,
+                  ParamTypes&& ...params) ->
+    std::enable_if_t<impl::is_libc_predicate_v<PredType>,
+                     std::invoke_result_t<FuncType, ParamTypes...>>
+{
+    SAFELIBCCALL_STATS_BEGIN();
+    errno = 0;
+    auto retval { std::forward<FuncType>(libc_func)(
+            std::forward<ParamTypes>(params)...) };
+    const bool failed { impl::libcCallFailed(is_failure, retval) };
+    SAFELIBCCALL_STATS_END(libc_func_name, failed);
+    if (SAFELIBCCALL_UNLIKELY(failed))
+        impl::throwLibcFailure(libc_func_name, errno);
+    return retval;
+}
+
+/*
+ * @brief Outcome of tryLibcCall: the libc return value, plus on failure the
+ *   errno and the name of the function, without any allocation.
+ *
+ * @notes Mirrors std::expected: check has_value() (or convert to bool) and
+ *   read with operator*, or call value(), which throws exactly what
+ *   safeLibcCall would have thrown for the same failure. libc_func_name must
+ *   outlive the result, as it is not copied; string literals always do.
+ */
+template<typename ReturnType>
+class LibcResult {
+public:
+    constexpr LibcResult(const ReturnType retval, const int err,
+                         const bool failed,
+                         const std::string_view libc_func_name) :
+        retval{ retval }, err{ err }, failed{ failed },
+        libc_func_name{ libc_func_name } {}
+
+    // widening, eg of an int-returning call's result to LibcResult<ssize_t>
+    template<typename OtherType, typename = std::enable_if_t<
+                 !std::is_same_v<OtherType, ReturnType> &&
+                 std::is_convertible_v<OtherType, ReturnType>>>
+    constexpr LibcResult(const LibcResult<OtherType>& other) :
+        retval{ static_cast<ReturnType>(*other) }, err{ other.errnoValue() },
+        failed{ !other.has_value() }, libc_func_name{ other.funcName() } {}
+
+    constexpr bool has_value() const { return !failed; }
+    constexpr explicit operator bool() const { return !failed; }
+
+    /*
+     * @brief Returns the libc return value, or on failure throws
+     *   std::system_error (or std::runtime_error if errno was not set) with the
+     *   same message as safeLibcCall.
+     */
+    constexpr ReturnType value() const {
+        if (SAFELIBCCALL_UNLIKELY(failed))
+            impl::throwLibcFailure(libc_func_name, err);
+        return retval;
+    }
+
+    template<typename DefaultType>
+    constexpr ReturnType value_or(DefaultType&& default_val) const {
+        return failed ? static_cast<ReturnType>(
+            std::forward<DefaultType>(default_val)) : retval;
+    }
+
+    // unchecked, as for std::expected; on failure, the failing return value
+    constexpr const ReturnType& operator*() const { return retval; }
+
+    /*
+     * @brief errno of a failure, in std::generic_category as LibcError's
+     *   code(), empty (value 0) on success or for a failure that did not set
+     *   errno.
+     */
+    std::error_code error() const {
+        return failed ? impl::libcErrnoCode(err) : std::error_code();
+    }
+
+    constexpr int errnoValue() const { return failed ? err : 0; }
+    constexpr std::string_view funcName() const { return libc_func_name; }
+
+private:
+    ReturnType retval;
+    int err;
+    bool failed;
+    std::string_view libc_func_name;
+};
+
+/*
+ * @brief Non-throwing counterpart to safeLibcCall with a predicate policy,
+ *   for loops where failures such as EAGAIN are routine.
+ */
+template<typename FuncType, typename PredType, typename ...ParamTypes>
+auto tryLibcCall(FuncType&& libc_func,
+                 const std::string_view libc_func_name,
+                 const PredType is_failure,
+                 ParamTypes&& ...params) ->
+    std::enable_if_t<impl::is_libc_predicate_v<PredType>,
+                     LibcResult<std::invoke_result_t<FuncType, ParamTypes...>>>
+{
+    SAFELIBCCALL_STATS_BEGIN();
+    errno = 0;
+    const auto retval { std::forward<FuncType>(libc_func)(
+            std::forward<ParamTypes>(params)...) };
+    const bool failed { impl::libcCallFailed(is_failure, retval) };
+    SAFELIBCCALL_STATS_END(libc_func_name, failed);
+    return { retval, failed ? errno : 0, failed, libc_func_name };
+}
+
+/*
+ * @brief Non-throwing counterpart to safeLibcCall without a predicate, failing
+ *   on any non-zero errno.
+ */
+template<typename FuncType, typename ...ParamTypes>
+auto tryLibcCall(FuncType&& libc_func,
+                 const std::string_view libc_func_name,
+                 ParamTypes&& ...params) ->
+    LibcResult<std::invoke_result_t<FuncType, ParamTypes...>>
+{
+    return tryLibcCall(std::forward<FuncType>(libc_func), libc_func_name,
+                       errno_nonzero{}, std::forward<ParamTypes>(params)...);
+}
+
+/*
+ * Compile-time naming: with the libc function as a template argument, eg
+ *   `safeLibcCall<&open>(ret_eq<-1>{}, path, O_RDONLY)`, its name is taken from
+ *   the compiler's signature of a function templated on it (as typeName.hh
+ *   does for types) and kept in static constexpr storage, so that no name is
+ *   written out, or passed on the success path. From C++20, safeLibcCall with
+ *   a predicate also keeps its call site, as a std::source_location.
+ */
+
+// a function of known name, to measure the text around it in
+//   impl::rawLibcFuncName; in the global namespace as g++ writes names
+//   relative to the namespace of the function templated on them
+inline void safeLibcCallNameProbe() {}
+
+namespace impl {
+
+/*
+ * @brief Signature of this function, which names LibcFunc among its template
+ *   arguments.
+ */
+template<auto LibcFunc>
+constexpr std::string_view rawLibcFuncName() {
+#ifndef _MSC_VER
+    return __PRETTY_FUNCTION__;
+#else   // MSVC
+    return __FUNCSIG__;
+#endif  // MSVC
+}
+
+struct LibcFuncNameFormat {
+    std::size_t prefix_sz { 0 };
+    std::size_t total_extra_chars { 0 };
+};
+
+constexpr LibcFuncNameFormat libc_func_name_format {
+    []() constexpr {
+        constexpr std::string_view probe_name { "safeLibcCallNameProbe" };
+        constexpr std::string_view raw_name {
+            rawLibcFuncName<&safeLibcCallNameProbe>() };
+        return LibcFuncNameFormat {
+            raw_name.find(probe_name),           // prefix_sz
+            raw_name.size() - probe_name.size()  // total_extra_chars
+        };
+    }()
+};
+static_assert(libc_func_name_format.prefix_sz != std::string_view::npos,
+              "Unable to determine the function name format on this compiler.");
+
+template<auto LibcFunc>
+inline constexpr std::string_view libc_func_name_storage {
+    []() constexpr {
+        constexpr std::string_view raw_name { rawLibcFuncName<LibcFunc>() };
+        return raw_name.substr(
+            libc_func_name_format.prefix_sz,
+            raw_name.size() - libc_func_name_format.total_extra_chars);
+    }()
+};
+
+template<typename ...ParamTypes>
+struct first_is_libc_predicate : std::false_type {};
+
+template<typename FirstType, typename ...ParamTypes>
+struct first_is_libc_predicate<FirstType, ParamTypes...> :
+        is_libc_predicate<std::decay_t<FirstType>> {};
+
+}  // namespace impl
+
+/*
+ * @brief Name of LibcFunc, as qualified in its declaration, eg "open" for
+ *   `&open`; LibcFunc must name a function, not a lambda.
+ */
+template<auto LibcFunc>
+constexpr std::string_view libcFuncName() {
+    return impl::libc_func_name_storage<LibcFunc>;
+}
+
+#if __cplusplus >= 202002L
+namespace impl {
+
+/*
+ * @brief The predicate argument of the compile-time-named safeLibcCall,
+ *   capturing the call site in a defaulted argument of its constructor, as the
+ *   variadic safeLibcCall cannot default one of its own.
+ *
+ * @notes std::source_location points to data in static storage, so the site
+ *   is one pointer. The predicate is held by address for the duration of the
+ *   call and tested through a function pointer, both folded away when the
+ *   constructor inlines, leaving the success path as before.
+ */
+template<typename ReturnType>
+class SitedLibcPredicate {
+public:
+    template<typename PredType,
+             typename = std::enable_if_t<is_libc_predicate_v<PredType>>>
+    constexpr SitedLibcPredicate(const PredType& is_failure,
+                                 const std::source_location call_site =
+                                     std::source_location::current()) :
+        pred{ &is_failure },
+        test{ [](const void* pred, const ReturnType& retval) {
+            return libcCallFailed(*static_cast<const PredType*>(pred), retval);
+        } },
+        site{ call_site } {}
+
+    constexpr bool failed(const ReturnType& retval) const {
+        return test(pred, retval);
     }
+
+    constexpr std::source_location callSite() const { return site; }
+
+private:
+    const void* pred;
+    bool (*test)(const void*, const ReturnType&);
+    std::source_location site;
+};
+
+}  // namespace impl
+
+/*
+ * @brief safeLibcCall(LibcFunc, libcFuncName<LibcFunc>(), is_failure,
+ *   params...): the predicate overload, named at compile time, with the call
+ *   site also kept for LibcError::callSite().
+ */
+template<auto LibcFunc, typename ...ParamTypes>
+auto safeLibcCall(
+    const impl::SitedLibcPredicate<
+        std::invoke_result_t<decltype(LibcFunc), ParamTypes...>> is_failure,
+    ParamTypes&& ...params) ->
+    std::invoke_result_t<decltype(LibcFunc), ParamTypes...>
+{
+    constexpr std::string_view libc_func_name { libcFuncName<LibcFunc>() };
+    SAFELIBCCALL_STATS_BEGIN();
+    errno = 0;
+    auto retval { LibcFunc(std::forward<ParamTypes>(params)...) };
+    const bool failed { is_failure.failed(retval) };
+    SAFELIBCCALL_STATS_END(libc_func_name, failed);
+    if (SAFELIBCCALL_UNLIKELY(failed))
+        impl::throwLibcFailure(libc_func_name, errno, is_failure.callSite());
     return retval;
 }
+#else
+/*
+ * @brief safeLibcCall(LibcFunc, libcFuncName<LibcFunc>(), is_failure,
+ *   params...): the predicate overload, named at compile time.
+ */
+template<auto LibcFunc, typename PredType, typename ...ParamTypes>
+auto safeLibcCall(const PredType is_failure, ParamTypes&& ...params) ->
+    std::enable_if_t<impl::is_libc_predicate_v<PredType>,
+                     std::invoke_result_t<decltype(LibcFunc), ParamTypes...>>
+{
+    return safeLibcCall(LibcFunc, libcFuncName<LibcFunc>(), is_failure,
+                        std::forward<ParamTypes>(params)...);
+}
+#endif
+
+/*
+ * @brief As above, failing on any non-zero errno.
+ */
+template<auto LibcFunc, typename ...ParamTypes>
+auto safeLibcCall(ParamTypes&& ...params) ->
+    std::enable_if_t<!impl::first_is_libc_predicate<ParamTypes...>::value,
+                     std::invoke_result_t<decltype(LibcFunc), ParamTypes...>>
+{
+    return safeLibcCall(LibcFunc, libcFuncName<LibcFunc>(), errno_nonzero{},
+                        std::forward<ParamTypes>(params)...);
+}
+
+/*
+ * @brief tryLibcCall(LibcFunc, libcFuncName<LibcFunc>(), is_failure,
+ *   params...), named at compile time.
+ */
+template<auto LibcFunc, typename PredType, typename ...ParamTypes>
+auto tryLibcCall(const PredType is_failure, ParamTypes&& ...params) ->
+    std::enable_if_t<impl::is_libc_predicate_v<PredType>,
+                     LibcResult<std::invoke_result_t<decltype(LibcFunc),
+                                                     ParamTypes...>>>
+{
+    return tryLibcCall(LibcFunc, libcFuncName<LibcFunc>(), is_failure,
+                       std::forward<ParamTypes>(params)...);
+}
+
+/*
+ * @brief As above, failing on any non-zero errno.
+ */
+template<auto LibcFunc, typename ...ParamTypes>
+auto tryLibcCall(ParamTypes&& ...params) ->
+    std::enable_if_t<!impl::first_is_libc_predicate<ParamTypes...>::value,
+                     LibcResult<std::invoke_result_t<decltype(LibcFunc),
+                                                     ParamTypes...>>>
+{
+    return tryLibcCall(LibcFunc, libcFuncName<LibcFunc>(), errno_nonzero{},
+                       std::forward<ParamTypes>(params)...);
+}
 
 #endif  // SAFELIBCCALL_HH
@@ -0,0 +1,159 @@
+#ifndef SAFELIBCERROR_HH
+#define SAFELIBCERROR_HH
+
+
+#include <algorithm>     // min
+#include <array>
+#include <cstddef>       // size_t
+#include <cstring>       // memcpy
+#include <stdexcept>     // runtime_error
+#include <string>
+#include <string_view>
+#include <system_error>  // error_code, error_condition, system_category
+#if __cplusplus >= 202002L
+#include <source_location>
+#endif
+
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SAFELIBCCALL_COLD __attribute__((noinline, cold))
+#define SAFELIBCCALL_UNLIKELY(cond) __builtin_expect(!!(cond), 0)
+#else
+#define SAFELIBCCALL_COLD
+#define SAFELIBCCALL_UNLIKELY(cond) (cond)
+#endif
+
+/*
+ * Exceptions thrown by safeLibcCall: std::system_error, but with what()
+ *   copied from interned strerror messages rather than concatenated with the
+ *   name at each throw, as failures such as ENOENT may come in storms. The
+ *   std::system_error base still formats code().message() (a strerror call
+ *   and a string) at each throw, so a throw is cheaper but not free.
+ */
+
+namespace impl {
+
+/*
+ * @brief Message for each errno (as strerror), formatted once on first use.
+ */
+class ErrnoMessageTable {
+public:
+    static constexpr int errno_ct { 256 };  // Linux uses up to 133
+
+    ErrnoMessageTable() {
+        for (int err { 0 }; err < errno_ct; ++err)
+            messages[static_cast<std::size_t>(err)] =
+                std::system_category().message(err);
+    }
+
+    std::string_view operator[](const int err) const {
+        if (err < 0 || err >= errno_ct)
+            return "Unknown error";
+        return messages[static_cast<std::size_t>(err)];
+    }
+
+private:
+    std::array<std::string, errno_ct> messages;
+};
+
+inline const ErrnoMessageTable& errnoMessages() {
+    static const ErrnoMessageTable table;
+    return table;
+}
+
+/*
+ * @brief errno as std::system_category maps it to an error condition, so in
+ *   std::generic_category for any errno value.
+ */
+inline std::error_code libcErrnoCode(const int err) {
+    const std::error_condition econd {
+        std::system_category().default_error_condition(err) };
+    return { econd.value(), econd.category() };
+}
+
+}  // namespace impl
+
+/*
+ * @brief The std::system_error thrown for a failed libc call, with what() of
+ *   "<libc_func_name>: <strerror message>" as before, built by copying the
+ *   name and the interned message into a buffer in the exception object.
+ *
+ * @notes code() is in std::generic_category, as before, at the cost of the
+ *   base formatting code().message() at each throw: 2 operator new calls per
+ *   throw, down from 3. Names past 64 characters are truncated in what().
+ */
+class LibcError : public std::system_error {
+public:
+    LibcError(const std::string_view libc_func_name, const int err) :
+        std::system_error(impl::libcErrnoCode(err)) {
+        const std::string_view sep { ": " };
+        const std::string_view message { impl::errnoMessages()[err] };
+        name_len = std::min(libc_func_name.size(), max_name_len);
+        const std::size_t message_len {
+            std::min(message.size(), what_buf_sz - 1 - name_len - sep.size()) };
+        char* out { what_buf };
+        std::memcpy(out, libc_func_name.data(), name_len);
+        std::memcpy(out += name_len, sep.data(), sep.size());
+        std::memcpy(out += sep.size(), message.data(), message_len);
+        out[message_len] = '\0';
+    }
+
+#if __cplusplus >= 202002L
+    LibcError(const std::string_view libc_func_name, const int err,
+              const std::source_location call_site) :
+        LibcError(libc_func_name, err) {
+        site = call_site;
+    }
+#endif
+
+    const char* what() const noexcept override { return what_buf; }
+
+    std::string_view funcName() const noexcept { return { what_buf, name_len }; }
+
+#if __cplusplus >= 202002L
+    // of a failed compile-time-named safeLibcCall with a predicate, else line 0
+    std::source_location callSite() const noexcept { return site; }
+#endif
+
+private:
+    static constexpr std::size_t what_buf_sz { 160 };
+    static constexpr std::size_t max_name_len { 64 };
+
+    char what_buf[what_buf_sz];
+    std::size_t name_len;
+#if __cplusplus >= 202002L
+    std::source_location site {};
+#endif
+};
+
+namespace impl {
+
+/*
+ * @brief Throws LibcError, or std::runtime_error if errno was not set; kept
+ *   out of line and marked cold so as not to weigh on the success path.
+ */
+[[noreturn]] SAFELIBCCALL_COLD
+inline void throwLibcFailure(const std::string_view libc_func_name,
+                             const int err) {
+    if (err == 0) {
+        throw std::runtime_error(std::string(libc_func_name) +
+                                 ": failure without setting errno");
+    }
+    throw LibcError(libc_func_name, err);
+}
+
+#if __cplusplus >= 202002L
+[[noreturn]] SAFELIBCCALL_COLD
+inline void throwLibcFailure(const std::string_view libc_func_name,
+                             const int err,
+                             const std::source_location call_site) {
+    if (err == 0)
+        throwLibcFailure(libc_func_name, err);
+    throw LibcError(libc_func_name, err, call_site);
+}
+#endif
+
+}  // namespace impl
+
+
+#endif  // SAFELIBCERROR_HH
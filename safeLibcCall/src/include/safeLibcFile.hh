@@ -0,0 +1,246 @@
+#ifndef SAFELIBCFILE_HH
+#define SAFELIBCFILE_HH
+
+
+#include "safeLibcCall.hh"
+
+#include <cstddef>       // byte, size_t
+#include <string_view>
+#include <utility>       // exchange
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+#include <fcntl.h>       // open, O_CLOEXEC, O_RDONLY
+#include <sys/mman.h>    // madvise, mmap, munmap
+#include <sys/stat.h>    // fstat
+#include <unistd.h>      // close, sysconf
+
+
+/*
+ * Owners of file descriptors and read-only file mappings, opened and mapped
+ *   through safeLibcCall so that failures throw and nothing leaks.
+ */
+
+/*
+ * @brief Owns a file descriptor, closing it on destruction; move-only.
+ *
+ * @notes Errors from close in the destructor or reset() are ignored, as the fd
+ *   is released either way.
+ */
+class UniqueFd {
+public:
+    UniqueFd() = default;
+
+    // takes ownership of `fd`, or of nothing if -1
+    explicit UniqueFd(const int fd) : fd{ fd } {}
+
+    /*
+     * @brief Opens `path` as open(2) does, always adding O_CLOEXEC; throws what
+     *   safeLibcCall throws on failure.
+     */
+    UniqueFd(const char* const path, const int flags, const mode_t mode = 0) :
+        fd{ safeLibcCall(open, "open", ret_eq<-1>{}, path, flags | O_CLOEXEC,
+                         mode) } {}
+
+    UniqueFd(UniqueFd&& other) noexcept : fd{ other.release() } {}
+
+    UniqueFd& operator=(UniqueFd&& other) noexcept {
+        if (this != &other)
+            reset(other.release());
+        return *this;
+    }
+
+    UniqueFd(const UniqueFd&) = delete;
+    UniqueFd& operator=(const UniqueFd&) = delete;
+
+    ~UniqueFd() { reset(); }
+
+    int get() const { return fd; }
+    explicit operator bool() const { return fd != -1; }
+
+    // gives up ownership without closing
+    int release() { return std::exchange(fd, -1); }
+
+    // closes the owned fd, if any, and takes ownership of `new_fd`
+    void reset(const int new_fd = -1) {
+        if (fd != -1)
+            close(fd);
+        fd = new_fd;
+    }
+
+private:
+    int fd { -1 };
+};
+
+namespace impl {
+
+// MAP_FAILED, a cast pointer, cannot be a ret_eq template argument
+struct ret_map_failed {
+    static constexpr LibcTestKind kind { LibcTestKind::Ret };
+    bool operator()(void* const ret) const { return ret == MAP_FAILED; }
+};
+
+}  // namespace impl
+
+/*
+ * @brief Hints for MappedFile::advise, each an madvise(2) advice.
+ */
+enum class MapAdvice {
+    Normal = MADV_NORMAL,
+    Sequential = MADV_SEQUENTIAL,  // aggressive readahead, pages freed behind
+    Random = MADV_RANDOM,          // no readahead
+    WillNeed = MADV_WILLNEED,      // start readahead now
+    DontNeed = MADV_DONTNEED,
+#ifdef MADV_HUGEPAGE
+    HugePage = MADV_HUGEPAGE,      // back with transparent huge pages
+#endif
+};
+
+/*
+ * @brief How MappedFile maps and faults in a file.
+ *
+ * @notes `populate` reads the whole file in and maps it during mmap
+ *   (MAP_POPULATE), before any hint applies; `prefault` does the same after
+ *   the hints, so that with `hugepages` the file can be faulted in as huge
+ *   pages. Hints the kernel rejects (eg huge pages for file mappings without
+ *   CONFIG_READ_ONLY_THP_FOR_FS) are ignored.
+ */
+struct MapOptions {
+    bool sequential { false };
+    bool willneed { false };
+    bool hugepages { false };
+    bool populate { false };
+    bool prefault { false };
+};
+
+/*
+ * @brief A read-only private mapping of a whole file, unmapped on destruction;
+ *   move-only. Reading through data(), view() or bytes() needs no copy into a
+ *   buffer, as the mapping is of the page cache itself.
+ *
+ * @notes The size is that of the file when mapped; reads past the end of a
+ *   file truncated since raise SIGBUS. Empty files map nothing, with data()
+ *   null.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    // maps the regular file open at `fd`, which may be closed afterwards
+    explicit MappedFile(const int fd, const MapOptions& options = {}) {
+        struct stat st;
+        safeLibcCall(fstat, "fstat", ret_eq<-1>{}, fd, &st);
+        len = static_cast<std::size_t>(st.st_size);
+        if (len == 0)
+            return;
+        addr = safeLibcCall(
+            mmap, "mmap", impl::ret_map_failed{}, nullptr, len, PROT_READ,
+            MAP_PRIVATE | (options.populate ? MAP_POPULATE : 0), fd, 0);
+        if (options.sequential)
+            hint(MapAdvice::Sequential);
+        if (options.willneed)
+            hint(MapAdvice::WillNeed);
+#ifdef MADV_HUGEPAGE
+        if (options.hugepages)
+            hint(MapAdvice::HugePage);
+#endif
+        if (options.prefault)
+            prefault();
+    }
+
+    explicit MappedFile(const char* const path, const MapOptions& options = {}) :
+        MappedFile(UniqueFd{ path, O_RDONLY }.get(), options) {}
+
+    MappedFile(MappedFile&& other) noexcept :
+        addr{ std::exchange(other.addr, nullptr) },
+        len{ std::exchange(other.len, 0) } {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            addr = std::exchange(other.addr, nullptr);
+            len = std::exchange(other.len, 0);
+        }
+        return *this;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() { unmap(); }
+
+    const std::byte* data() const { return static_cast<const std::byte*>(addr); }
+    std::size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+
+    std::string_view view() const {
+        return { static_cast<const char*>(addr), len };
+    }
+
+#if __cplusplus >= 202002L
+    std::span<const std::byte> bytes() const { return { data(), len }; }
+#endif
+
+    /*
+     * @brief Applies `advice` to the pages overlapping [offset, offset + count),
+     *   by default the whole mapping; throws what safeLibcCall throws if the
+     *   kernel rejects it.
+     */
+    void advise(const MapAdvice advice, const std::size_t offset = 0,
+                const std::size_t count = static_cast<std::size_t>(-1)) const {
+        if (len == 0 || offset >= len)
+            return;
+        // madvise takes a page-aligned start
+        const std::size_t start { offset - offset % pageSize() };
+        const std::size_t end { count > len - offset ? len : offset + count };
+        safeLibcCall(madvise, "madvise", ret_eq<-1>{},
+                     static_cast<char*>(addr) + start, end - start,
+                     static_cast<int>(advice));
+    }
+
+    /*
+     * @brief Faults in every page now rather than on first access: by
+     *   MADV_POPULATE_READ where the kernel (5.14 or later) has it, otherwise
+     *   by reading a byte from each page.
+     */
+    void prefault() const {
+        if (len == 0)
+            return;
+#ifdef MADV_POPULATE_READ
+        if (tryLibcCall(madvise, "madvise", ret_eq<-1>{}, addr, len,
+                        MADV_POPULATE_READ))
+            return;
+#endif
+        const volatile char* const bytes { static_cast<const char*>(addr) };
+        for (std::size_t i { 0 }; i < len; i += pageSize())
+            static_cast<void>(bytes[i]);
+    }
+
+private:
+    static std::size_t pageSize() {
+        static const std::size_t page_sz {
+            static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) };
+        return page_sz;
+    }
+
+    // hints from MapOptions are best-effort
+    void hint(const MapAdvice advice) const {
+        static_cast<void>(tryLibcCall(madvise, "madvise", ret_eq<-1>{}, addr,
+                                      len, static_cast<int>(advice)));
+    }
+
+    void unmap() {
+        if (addr != nullptr)
+            munmap(addr, len);
+        addr = nullptr;
+        len = 0;
+    }
+
+    void* addr { nullptr };
+    std::size_t len { 0 };
+};
+
+
+#endif  // SAFELIBCFILE_HH
@@ -0,0 +1,327 @@
+#ifndef SAFELIBCIO_HH
+#define SAFELIBCIO_HH
+
+
+#include "safeLibcCall.hh"
+
+#include <algorithm>     // min
+#include <cerrno>        // EAGAIN, EINTR, EWOULDBLOCK
+#include <chrono>
+#include <climits>       // IOV_MAX
+#include <cstddef>       // size_t
+#include <initializer_list>
+#include <string_view>
+#include <utility>       // forward
+
+#include <poll.h>        // poll
+#include <sys/socket.h>  // recv, send
+#include <sys/uio.h>     // readv, writev, iovec
+#include <unistd.h>      // read, write
+
+
+/*
+ * Retry policies for safeLibcCall and tryLibcCall, and helpers completing
+ *   short reads and writes, all reporting failures as safeLibcCall does.
+ */
+
+/*
+ * @brief Restarts calls failing with EINTR (interrupted by a signal handler).
+ */
+struct retry_eintr {};
+
+/*
+ * @brief Restarts calls failing with EINTR, and waits out EAGAIN/EWOULDBLOCK:
+ *   first by retrying up to `spin_ct` times at once, then by polling `fd` for
+ *   `events` (or, with no fd, sleeping 1ms per retry) for up to `timeout_ms`
+ *   in total, after which the EAGAIN failure is reported.
+ *
+ * @notes The transfer helpers below fill in `fd` and `events` themselves.
+ */
+struct retry_eagain {
+    int fd { -1 };
+    short events { 0 };          // eg POLLIN or POLLOUT
+    unsigned spin_ct { 4 };
+    int timeout_ms { -1 };       // negative to wait indefinitely
+};
+
+namespace impl {
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+inline bool isEagain(const int err) {
+    return err == EAGAIN || err == EWOULDBLOCK;
+}
+
+/*
+ * @brief Per-call retry state, deciding after each failure whether to retry.
+ */
+template<typename RetryType>
+class RetryState;
+
+template<>
+class RetryState<retry_eintr> {
+public:
+    explicit RetryState(const retry_eintr&) {}
+    bool shouldRetry(const int err) { return err == EINTR; }
+};
+
+template<>
+class RetryState<retry_eagain> {
+public:
+    explicit RetryState(const retry_eagain& policy) :
+        policy{ policy }, spins{ 0 }, started{ false }, deadline{} {}
+
+    bool shouldRetry(const int err) {
+        if (err == EINTR)
+            return true;
+        if (!isEagain(err))
+            return false;
+        if (spins < policy.spin_ct) {
+            ++spins;
+            cpuRelax();
+            return true;
+        }
+        spins = 0;
+        return waitReady();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    bool waitReady() {
+        int wait_ms { policy.fd < 0 ? 1 : -1 };
+        if (policy.timeout_ms >= 0) {
+            const Clock::time_point now { Clock::now() };
+            if (!started) {
+                deadline = now + std::chrono::milliseconds(policy.timeout_ms);
+                started = true;
+            }
+            if (now >= deadline)
+                return false;
+            const int remaining_ms { static_cast<int>(
+                std::chrono::ceil<std::chrono::milliseconds>(
+                    deadline - now).count()) };
+            wait_ms = wait_ms < 0 ? remaining_ms :
+                std::min(wait_ms, remaining_ms);
+        }
+        if (policy.fd < 0) {
+            poll(nullptr, 0, wait_ms);
+            return true;
+        }
+        pollfd target { policy.fd, policy.events, 0 };
+        int ready;
+        do {
+            ready = poll(&target, 1, wait_ms);
+        } while (ready == -1 && errno == EINTR);
+        // on poll error let the retried call report its own failure
+        return ready != 0;
+    }
+
+    retry_eagain policy;
+    unsigned spins;
+    bool started;
+    Clock::time_point deadline;
+};
+
+inline retry_eintr withPollTarget(const retry_eintr& retry, int, short) {
+    return retry;
+}
+
+inline retry_eagain withPollTarget(retry_eagain retry, const int fd,
+                                   const short events) {
+    retry.fd = fd;
+    retry.events = events;
+    return retry;
+}
+
+}  // namespace impl
+
+/*
+ * @brief tryLibcCall, repeated while `retry` allows; returns the first
+ *   success or the failure that ended retrying.
+ *
+ * @notes params are passed as lvalues to every attempt, so are never moved
+ *   from.
+ */
+template<typename RetryType, typename FuncType, typename PredType,
+         typename ...ParamTypes>
+auto tryLibcCallRetry(const RetryType& retry, FuncType&& libc_func,
+                      const std::string_view libc_func_name,
+                      const PredType is_failure, ParamTypes&& ...params) ->
+    std::enable_if_t<impl::is_libc_predicate_v<PredType>,
+                     LibcResult<std::invoke_result_t<FuncType, ParamTypes...>>>
+{
+    impl::RetryState<RetryType> state { retry };
+    for (;;) {
+        const auto result { tryLibcCall(libc_func, libc_func_name, is_failure,
+                                        params...) };
+        if (result || !state.shouldRetry(result.errnoValue()))
+            return result;
+    }
+}
+
+/*
+ * @brief safeLibcCall, repeated while `retry` allows; throws as safeLibcCall
+ *   for the failure that ended retrying.
+ */
+template<typename RetryType, typename FuncType, typename PredType,
+         typename ...ParamTypes>
+auto safeLibcCallRetry(const RetryType& retry, FuncType&& libc_func,
+                       const std::string_view libc_func_name,
+                       const PredType is_failure, ParamTypes&& ...params) ->
+    std::enable_if_t<impl::is_libc_predicate_v<PredType>,
+                     std::invoke_result_t<FuncType, ParamTypes...>>
+{
+    return tryLibcCallRetry(retry, std::forward<FuncType>(libc_func),
+                            libc_func_name, is_failure,
+                            std::forward<ParamTypes>(params)...).value();
+}
+
+/*
+ * @brief Reads until `len` bytes or end of file, returning the count read.
+ */
+template<typename RetryType = retry_eintr>
+std::size_t readAll(const int fd, void* const buf, const std::size_t len,
+                    const RetryType& retry = {}) {
+    const RetryType target { impl::withPollTarget(retry, fd, POLLIN) };
+    char* const bytes { static_cast<char*>(buf) };
+    std::size_t done { 0 };
+    while (done < len) {
+        const ssize_t ct { safeLibcCallRetry(target, ::read, "read",
+                                             ret_eq<-1>{}, fd, bytes + done,
+                                             len - done) };
+        if (ct == 0)
+            break;
+        done += static_cast<std::size_t>(ct);
+    }
+    return done;
+}
+
+/*
+ * @brief Writes all `len` bytes.
+ */
+template<typename RetryType = retry_eintr>
+void writeAll(const int fd, const void* const buf, const std::size_t len,
+              const RetryType& retry = {}) {
+    const RetryType target { impl::withPollTarget(retry, fd, POLLOUT) };
+    const char* const bytes { static_cast<const char*>(buf) };
+    for (std::size_t done { 0 }; done < len;) {
+        done += static_cast<std::size_t>(
+            safeLibcCallRetry(target, ::write, "write", ret_eq<-1>{}, fd,
+                              bytes + done, len - done));
+    }
+}
+
+/*
+ * @brief Receives until `len` bytes or orderly shutdown by the peer, returning
+ *   the count received.
+ */
+template<typename RetryType = retry_eintr>
+std::size_t recvAll(const int sockfd, void* const buf, const std::size_t len,
+                    const int flags, const RetryType& retry = {}) {
+    const RetryType target { impl::withPollTarget(retry, sockfd, POLLIN) };
+    char* const bytes { static_cast<char*>(buf) };
+    std::size_t done { 0 };
+    while (done < len) {
+        const ssize_t ct { safeLibcCallRetry(target, ::recv, "recv",
+                                             ret_eq<-1>{}, sockfd, bytes + done,
+                                             len - done, flags) };
+        if (ct == 0)
+            break;
+        done += static_cast<std::size_t>(ct);
+    }
+    return done;
+}
+
+/*
+ * @brief Sends all `len` bytes; pass MSG_NOSIGNAL in `flags` to get EPIPE
+ *   rather than SIGPIPE from a closed peer.
+ */
+template<typename RetryType = retry_eintr>
+void sendAll(const int sockfd, const void* const buf, const std::size_t len,
+             const int flags, const RetryType& retry = {}) {
+    const RetryType target { impl::withPollTarget(retry, sockfd, POLLOUT) };
+    const char* const bytes { static_cast<const char*>(buf) };
+    for (std::size_t done { 0 }; done < len;) {
+        done += static_cast<std::size_t>(
+            safeLibcCallRetry(target, ::send, "send", ret_eq<-1>{}, sockfd,
+                              bytes + done, len - done, flags));
+    }
+}
+
+/*
+ * @brief Writes all buffers in order, as few writev calls as possible (up to
+ *   IOV_MAX buffers each), returning the total count written.
+ *
+ * @notes `iov` is not modified: a buffer left partly written is finished by
+ *   write() before writev resumes with the next.
+ */
+template<typename RetryType = retry_eintr>
+std::size_t writevAll(const int fd, const iovec* iov, int iovcnt,
+                      const RetryType& retry = {}) {
+    const RetryType target { impl::withPollTarget(retry, fd, POLLOUT) };
+    std::size_t total { 0 };
+    while (iovcnt > 0) {
+        std::size_t ct { static_cast<std::size_t>(
+            safeLibcCallRetry(target, ::writev, "writev", ret_eq<-1>{}, fd,
+                              iov, std::min(iovcnt, IOV_MAX))) };
+        total += ct;
+        for (; iovcnt > 0 && ct >= iov->iov_len; ++iov, --iovcnt)
+            ct -= iov->iov_len;
+        if (ct != 0) {
+            writeAll(fd, static_cast<const char*>(iov->iov_base) + ct,
+                     iov->iov_len - ct, target);
+            total += iov->iov_len - ct;
+            ++iov;
+            --iovcnt;
+        }
+    }
+    return total;
+}
+
+template<typename RetryType = retry_eintr>
+std::size_t writevAll(const int fd, const std::initializer_list<iovec> iov,
+                      const RetryType& retry = {}) {
+    return writevAll(fd, iov.begin(), static_cast<int>(iov.size()), retry);
+}
+
+/*
+ * @brief Reads into all buffers in order until they are full or end of file,
+ *   returning the total count read.
+ *
+ * @notes As for writevAll, `iov` is not modified.
+ */
+template<typename RetryType = retry_eintr>
+std::size_t readvAll(const int fd, const iovec* iov, int iovcnt,
+                     const RetryType& retry = {}) {
+    const RetryType target { impl::withPollTarget(retry, fd, POLLIN) };
+    std::size_t total { 0 };
+    while (iovcnt > 0) {
+        std::size_t ct { static_cast<std::size_t>(
+            safeLibcCallRetry(target, ::readv, "readv", ret_eq<-1>{}, fd,
+                              iov, std::min(iovcnt, IOV_MAX))) };
+        if (ct == 0)
+            break;
+        total += ct;
+        for (; iovcnt > 0 && ct >= iov->iov_len; ++iov, --iovcnt)
+            ct -= iov->iov_len;
+        if (ct != 0) {
+            const std::size_t rest { iov->iov_len - ct };
+            const std::size_t rest_ct { readAll(
+                    fd, static_cast<char*>(iov->iov_base) + ct, rest, target) };
+            total += rest_ct;
+            if (rest_ct < rest)
+                break;
+            ++iov;
+            --iovcnt;
+        }
+    }
+    return total;
+}
+
+
+#endif  // SAFELIBCIO_HH
@@ -0,0 +1,104 @@
+#ifndef SAFELIBCPOOL_HH
+#define SAFELIBCPOOL_HH
+
+
+#include <condition_variable>
+#include <cstddef>       // size_t
+#include <cstdint>       // uint64_t
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/*
+ * Persistent worker threads shared by the parallel paths of LibcBatch and
+ *   bulkLibcCall, which differ only in how a round's work is divided.
+ */
+
+namespace impl {
+
+/*
+ * @brief Persistent threads, started once, each running one call of a
+ *   round's function per run(), the calling thread joining in.
+ */
+class WorkerThreads {
+public:
+    explicit WorkerThreads(const unsigned thread_ct) {
+        for (unsigned w { 1 }; w < thread_ct; ++w)
+            threads.emplace_back([this, w]() { work(w); });
+    }
+
+    ~WorkerThreads() {
+        {
+            const std::lock_guard<std::mutex> lock { mtx };
+            stopping = true;
+        }
+        start_cv.notify_all();
+        for (std::thread& t : threads)
+            t.join();
+    }
+
+    WorkerThreads(const WorkerThreads&) = delete;
+    WorkerThreads& operator=(const WorkerThreads&) = delete;
+
+    // including the caller of run()
+    unsigned threadCount() const {
+        return static_cast<unsigned>(threads.size()) + 1;
+    }
+
+    /*
+     * @brief Calls `round(w)` once on each thread w, the caller being thread
+     *   0, returning when all calls have.
+     */
+    void run(const std::function<void(std::size_t)>& round) {
+        {
+            const std::lock_guard<std::mutex> lock { mtx };
+            current = &round;
+            busy_ct = threads.size();
+            ++generation;
+        }
+        start_cv.notify_all();
+        round(0);
+        std::unique_lock<std::mutex> lock { mtx };
+        done_cv.wait(lock, [this]() { return busy_ct == 0; });
+        current = nullptr;
+    }
+
+private:
+    void work(const std::size_t w) {
+        std::uint64_t seen { 0 };
+        for (;;) {
+            const std::function<void(std::size_t)>* round;
+            {
+                std::unique_lock<std::mutex> lock { mtx };
+                start_cv.wait(lock, [&]() {
+                    return stopping || generation != seen; });
+                if (stopping)
+                    return;
+                seen = generation;
+                round = current;
+            }
+            (*round)(w);
+            {
+                const std::lock_guard<std::mutex> lock { mtx };
+                --busy_ct;
+            }
+            done_cv.notify_one();
+        }
+    }
+
+    std::vector<std::thread> threads;
+    std::mutex mtx;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    const std::function<void(std::size_t)>* current { nullptr };
+    std::size_t busy_ct { 0 };
+    std::uint64_t generation { 0 };
+    bool stopping { false };
+};
+
+}  // namespace impl
+
+
+#endif  // SAFELIBCPOOL_HH
@@ -0,0 +1,455 @@
+#ifndef SAFELIBCSTATS_HH
+#define SAFELIBCSTATS_HH
+
+
+#include <algorithm>     // find, max, min
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>       // size_t
+#include <cstdint>       // uint64_t, uintptr_t
+#include <functional>
+#include <map>
+#include <memory>        // unique_ptr
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>       // move, pair
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>   // __rdtsc
+#define SAFELIBCCALL_STATS_TSC 1
+#endif
+
+
+/*
+ * Per-function call counts, errno counts and latency histograms for calls
+ *   through safeLibcCall and tryLibcCall, recorded only when
+ *   SAFELIBCCALL_INSTRUMENT is defined before including safeLibcCall.hh (it
+ *   must then be defined in every translation unit of the program).
+ *   Calls are keyed by their libc_func_name, so passing a distinct name per
+ *   call site, eg "open(config)", keys by call site.
+ *   Each thread records into its own counters, without locks or atomic
+ *   read-modify-writes; libcStatsSnapshot() merges them across threads.
+ */
+
+namespace impl {
+
+// HDR-style log buckets: exact below 8ns, then 8 per power of 2 (so within
+//   12.5%), up to 2^40ns (about 18 minutes)
+constexpr unsigned latency_sub_bucket_bits { 3 };
+constexpr unsigned latency_max_bits { 40 };
+constexpr std::size_t latency_bucket_ct {
+    (latency_max_bits - latency_sub_bucket_bits + 1) << latency_sub_bucket_bits };
+
+constexpr std::size_t latencyBucket(std::uint64_t ns) {
+    constexpr std::uint64_t sub_bucket_ct { 1u << latency_sub_bucket_bits };
+    if (ns < sub_bucket_ct)
+        return static_cast<std::size_t>(ns);
+    if (ns >> latency_max_bits)
+        ns = (std::uint64_t{ 1 } << latency_max_bits) - 1;
+    unsigned msb { 0 };
+    for (std::uint64_t v { ns }; v >>= 1;)
+        ++msb;
+    const unsigned shift { msb - latency_sub_bucket_bits };
+    return ((shift + 1) << latency_sub_bucket_bits) +
+        static_cast<std::size_t>((ns >> shift) & (sub_bucket_ct - 1));
+}
+
+// smallest latency in bucket `i`
+constexpr std::uint64_t latencyBucketLow(const std::size_t i) {
+    constexpr std::size_t sub_bucket_ct { 1u << latency_sub_bucket_bits };
+    if (i < sub_bucket_ct)
+        return i;
+    const std::size_t shift { (i >> latency_sub_bucket_bits) - 1 };
+    return static_cast<std::uint64_t>(sub_bucket_ct + (i & (sub_bucket_ct - 1)))
+        << shift;
+}
+
+// errno values above the last slot share it
+constexpr std::size_t errno_slot_ct { 134 };
+
+/*
+ * @brief Counters for one name in one thread. Only the owning thread writes,
+ *   so increments are a relaxed load and store rather than a locked add;
+ *   being atomic, they may still be read by the merging thread meanwhile.
+ */
+struct CallSiteCounters {
+    using Counter = std::atomic<std::uint64_t>;
+
+    explicit CallSiteCounters(const std::string_view name) : name{ name } {}
+
+    static void bump(Counter& c, const std::uint64_t n = 1) {
+        c.store(c.load(std::memory_order_relaxed) + n,
+                std::memory_order_relaxed);
+    }
+
+    const std::string name;
+    Counter call_ct { 0 };
+    Counter fail_ct { 0 };
+    Counter total_ns { 0 };
+    Counter max_ns { 0 };
+    std::array<Counter, latency_bucket_ct> latency {};
+    std::array<Counter, errno_slot_ct> errnos {};
+};
+
+class StatsRegistry;
+StatsRegistry& statsRegistry();
+
+/*
+ * @brief One thread's counters, registered for merging while the thread
+ *   lives and folded into the registry's retired totals when it exits.
+ */
+class ThreadStats {
+public:
+    static constexpr std::size_t max_site_ct { 256 };
+    static constexpr std::string_view overflow_name { "(other)" };
+
+    ThreadStats();
+    ~ThreadStats();
+
+    /*
+     * @brief Counters for `name`, found first in a small cache keyed by the
+     *   name's address, as names are usually string literals, then by value.
+     */
+    CallSiteCounters& site(const std::string_view name) {
+        CacheEntry& entry { cache[(reinterpret_cast<std::uintptr_t>(name.data())
+                                   >> 3) % cache_sz] };
+        // (an empty slot matches names with null data, eg std::string_view{})
+        if (entry.counters != nullptr && entry.data == name.data() &&
+            entry.counters->name == name)
+            return *entry.counters;
+        CallSiteCounters& found { lookup(name) };
+        entry = { name.data(), &found };
+        return found;
+    }
+
+    template<typename SiteFunc>
+    void forEachSite(SiteFunc func) const {
+        const std::size_t ct { site_ct.load(std::memory_order_acquire) };
+        for (std::size_t i { 0 }; i < ct; ++i)
+            func(*sites[i]);
+    }
+
+private:
+    static constexpr std::size_t cache_sz { 64 };
+
+    struct CacheEntry {
+        const char* data { nullptr };
+        CallSiteCounters* counters { nullptr };
+    };
+
+    CallSiteCounters& lookup(const std::string_view name) {
+        const auto it { index.find(name) };
+        if (it != index.end())
+            return *it->second;
+        const std::size_t ct { site_ct.load(std::memory_order_relaxed) };
+        // the last slot is kept for all names beyond the others
+        if (ct >= max_site_ct - 1 && name != overflow_name)
+            return lookup(overflow_name);
+        sites[ct] = std::make_unique<CallSiteCounters>(name);
+        CallSiteCounters& added { *sites[ct] };
+        index.emplace(added.name, &added);
+        // publishes the new counters to the merging thread
+        site_ct.store(ct + 1, std::memory_order_release);
+        return added;
+    }
+
+    std::array<CacheEntry, cache_sz> cache {};
+    std::array<std::unique_ptr<CallSiteCounters>, max_site_ct> sites {};
+    std::atomic<std::size_t> site_ct { 0 };
+    std::unordered_map<std::string_view, CallSiteCounters*> index;  // owner only
+};
+
+inline ThreadStats& threadStats() {
+    thread_local ThreadStats stats;
+    return stats;
+}
+
+inline std::uint64_t statsClockNs() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#ifdef SAFELIBCCALL_STATS_TSC
+/*
+ * @brief Timestamps by the TSC, which costs a fraction of a steady_clock read
+ *   (about half even in a VM trapping it), assumed invariant and synchronized
+ *   across cores as on all recent x86.
+ */
+inline std::uint64_t statsTicks() { return __rdtsc(); }
+
+/*
+ * @brief TSC period, measured against steady_clock over 2ms on first use,
+ *   which stats_tsc_calibration makes program startup.
+ */
+inline double statsNsPerTick() {
+    static const double ns_per_tick { []() {
+        const std::uint64_t start_ns { statsClockNs() };
+        const std::uint64_t start_ticks { __rdtsc() };
+        std::uint64_t ns;
+        do {
+            ns = statsClockNs() - start_ns;
+        } while (ns < 2'000'000);
+        return static_cast<double>(ns) /
+            static_cast<double>(__rdtsc() - start_ticks);
+    }() };
+    return ns_per_tick;
+}
+
+// calibrates during static initialization of any program instrumenting
+//   calls, so that the first recorded call does not stall for it
+inline const double stats_tsc_calibration { statsNsPerTick() };
+#else
+inline std::uint64_t statsTicks() { return statsClockNs(); }
+inline double statsNsPerTick() { return 1; }
+#endif
+
+/*
+ * @brief Records a call that began at statsTicks() `start_ticks`, leaving
+ *   errno unchanged.
+ */
+inline void recordLibcCall(const std::string_view libc_func_name,
+                           const std::uint64_t start_ticks, const bool failed) {
+    const std::uint64_t end_ticks { statsTicks() };
+    const int err { errno };
+    // (the thread may have moved to a core with a TSC slightly behind)
+    const std::uint64_t ns { end_ticks < start_ticks ? 0 :
+        static_cast<std::uint64_t>(
+            static_cast<double>(end_ticks - start_ticks) * statsNsPerTick()) };
+    CallSiteCounters& c { threadStats().site(libc_func_name) };
+    CallSiteCounters::bump(c.call_ct);
+    CallSiteCounters::bump(c.total_ns, ns);
+    if (ns > c.max_ns.load(std::memory_order_relaxed))
+        c.max_ns.store(ns, std::memory_order_relaxed);
+    CallSiteCounters::bump(c.latency[latencyBucket(ns)]);
+    if (failed) {
+        CallSiteCounters::bump(c.fail_ct);
+        const std::size_t slot { err < 0 ? 0 :
+            std::min(static_cast<std::size_t>(err), errno_slot_ct - 1) };
+        CallSiteCounters::bump(c.errnos[slot]);
+    }
+    errno = err;
+}
+
+}  // namespace impl
+
+/*
+ * @brief Merged counts for one libc_func_name across threads.
+ */
+struct LibcCallStats {
+    std::string name;
+    std::uint64_t call_ct { 0 };
+    std::uint64_t fail_ct { 0 };
+    std::uint64_t total_ns { 0 };
+    std::uint64_t max_ns { 0 };
+    std::vector<std::uint64_t> latency_cts =
+        std::vector<std::uint64_t>(impl::latency_bucket_ct);
+    std::map<int, std::uint64_t> errno_cts;  // failures by errno, 0 if unset
+
+    /*
+     * @brief Latency at or below which fraction `p` of calls completed, to
+     *   within the 12.5% resolution of the buckets (rounded up).
+     */
+    std::uint64_t percentileNs(const double p) const {
+        const double rank { p * static_cast<double>(call_ct) };
+        std::uint64_t seen { 0 };
+        for (std::size_t i { 0 }; i < latency_cts.size(); ++i) {
+            seen += latency_cts[i];
+            if (seen != 0 && static_cast<double>(seen) >= rank)
+                return std::min(max_ns, impl::latencyBucketLow(i + 1) - 1);
+        }
+        return max_ns;
+    }
+
+    double meanNs() const {
+        return call_ct == 0 ? 0 :
+            static_cast<double>(total_ns) / static_cast<double>(call_ct);
+    }
+};
+
+namespace impl {
+
+inline void mergeSite(LibcCallStats& into, const CallSiteCounters& c) {
+    constexpr auto relaxed { std::memory_order_relaxed };
+    into.call_ct += c.call_ct.load(relaxed);
+    into.fail_ct += c.fail_ct.load(relaxed);
+    into.total_ns += c.total_ns.load(relaxed);
+    into.max_ns = std::max(into.max_ns, c.max_ns.load(relaxed));
+    for (std::size_t i { 0 }; i < latency_bucket_ct; ++i)
+        into.latency_cts[i] += c.latency[i].load(relaxed);
+    for (std::size_t i { 0 }; i < errno_slot_ct; ++i) {
+        if (const std::uint64_t ct { c.errnos[i].load(relaxed) }; ct != 0)
+            into.errno_cts[static_cast<int>(i)] += ct;
+    }
+}
+
+class StatsRegistry {
+public:
+    void add(const ThreadStats* const stats) {
+        const std::lock_guard<std::mutex> lock { mtx };
+        live.push_back(stats);
+    }
+
+    void retire(const ThreadStats* const stats) {
+        const std::lock_guard<std::mutex> lock { mtx };
+        stats->forEachSite([this](const CallSiteCounters& c) {
+            LibcCallStats& totals { retired[c.name] };
+            totals.name = c.name;
+            mergeSite(totals, c);
+        });
+        live.erase(std::find(live.begin(), live.end(), stats));
+    }
+
+    std::vector<LibcCallStats> snapshot() {
+        std::map<std::string, LibcCallStats> merged;
+        {
+            const std::lock_guard<std::mutex> lock { mtx };
+            merged = retired;
+            for (const ThreadStats* const stats : live) {
+                stats->forEachSite([&merged](const CallSiteCounters& c) {
+                    LibcCallStats& totals { merged[c.name] };
+                    totals.name = c.name;
+                    mergeSite(totals, c);
+                });
+            }
+        }
+        std::vector<LibcCallStats> sites;
+        sites.reserve(merged.size());
+        for (auto& [name, totals] : merged)
+            sites.push_back(std::move(totals));
+        return sites;
+    }
+
+private:
+    std::mutex mtx;
+    std::vector<const ThreadStats*> live;
+    std::map<std::string, LibcCallStats> retired;  // from exited threads
+};
+
+inline StatsRegistry& statsRegistry() {
+    static StatsRegistry registry;
+    return registry;
+}
+
+inline ThreadStats::ThreadStats() {
+    statsRegistry().add(this);
+}
+
+inline ThreadStats::~ThreadStats() {
+    statsRegistry().retire(this);
+}
+
+}  // namespace impl
+
+/*
+ * @brief Counts so far, merged across live and exited threads, by name.
+ *
+ * @notes Counters are read while other threads may be adding to them, so a
+ *   snapshot may be a few calls out of step between fields.
+ */
+inline std::vector<LibcCallStats> libcStatsSnapshot() {
+    return impl::statsRegistry().snapshot();
+}
+
+/*
+ * @brief One line per name: calls, failures, mean/p50/p99/max latency, and
+ *   failures by errno.
+ */
+inline void libcStatsDumpText(std::ostream& os,
+                              const std::vector<LibcCallStats>& snapshot) {
+    for (const LibcCallStats& s : snapshot) {
+        os << s.name << ": calls " << s.call_ct << ", failures " << s.fail_ct
+           << ", mean " << static_cast<std::uint64_t>(s.meanNs())
+           << "ns, p50 " << s.percentileNs(0.5) << "ns, p99 "
+           << s.percentileNs(0.99) << "ns, max " << s.max_ns << "ns";
+        for (const auto& [err, ct] : s.errno_cts)
+            os << ", errno " << err << " x" << ct;
+        os << '\n';
+    }
+}
+
+/*
+ * @brief A JSON array of one object per name, with latency buckets as
+ *   [lowest ns, count] pairs, omitting empty buckets.
+ */
+inline void libcStatsDumpJson(std::ostream& os,
+                              const std::vector<LibcCallStats>& snapshot) {
+    os << '[';
+    for (std::size_t i { 0 }; i < snapshot.size(); ++i) {
+        const LibcCallStats& s { snapshot[i] };
+        os << (i == 0 ? "" : ",") << "\n  {\"name\": \"";
+        for (const char c : s.name) {
+            if (c == '"' || c == '\\')
+                os << '\\';
+            os << c;
+        }
+        os << "\", \"calls\": " << s.call_ct << ", \"failures\": " << s.fail_ct
+           << ", \"total_ns\": " << s.total_ns << ", \"p50_ns\": "
+           << s.percentileNs(0.5) << ", \"p99_ns\": " << s.percentileNs(0.99)
+           << ", \"max_ns\": " << s.max_ns << ", \"errno\": {";
+        const char* sep { "" };
+        for (const auto& [err, ct] : s.errno_cts) {
+            os << sep << '"' << err << "\": " << ct;
+            sep = ", ";
+        }
+        os << "}, \"latency\": [";
+        sep = "";
+        for (std::size_t b { 0 }; b < s.latency_cts.size(); ++b) {
+            if (s.latency_cts[b] == 0)
+                continue;
+            os << sep << '[' << impl::latencyBucketLow(b) << ", "
+               << s.latency_cts[b] << ']';
+            sep = ", ";
+        }
+        os << "]}";
+    }
+    os << (snapshot.empty() ? "]\n" : "\n]\n");
+}
+
+/*
+ * @brief Background thread passing a snapshot to `sink` every `period`, and
+ *   once more on destruction.
+ */
+class LibcStatsReporter {
+public:
+    LibcStatsReporter(const std::chrono::milliseconds period,
+                      std::function<void(const std::vector<LibcCallStats>&)> sink) :
+        sink{ std::move(sink) },
+        thread{ [this, period]() {
+            std::unique_lock<std::mutex> lock { mtx };
+            while (!stop_cv.wait_for(lock, period, [this]() { return stopping; }))
+                this->sink(libcStatsSnapshot());
+        } } {}
+
+    ~LibcStatsReporter() {
+        {
+            const std::lock_guard<std::mutex> lock { mtx };
+            stopping = true;
+        }
+        stop_cv.notify_one();
+        thread.join();
+        sink(libcStatsSnapshot());
+    }
+
+    LibcStatsReporter(const LibcStatsReporter&) = delete;
+    LibcStatsReporter& operator=(const LibcStatsReporter&) = delete;
+
+private:
+    std::function<void(const std::vector<LibcCallStats>&)> sink;
+    std::mutex mtx;
+    std::condition_variable stop_cv;
+    bool stopping { false };
+    std::thread thread;  // last, so started once the rest is constructed
+};
+
+
+#endif  // SAFELIBCSTATS_HH
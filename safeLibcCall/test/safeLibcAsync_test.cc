@@ -0,0 +1,190 @@
+#if (_CATCH_VERSION_MAJOR == 3)
+  #include <catch2/catch_version_macros.hpp>               // CATCH_VERSION_MAJOR
+  #include <catch2/catch_test_macros.hpp>                  // TEST_CASE, SECTION, REQUIRE
+  #include <catch2/matchers/catch_matchers.hpp>            // REQUIRES_*THROW*
+  #include <catch2/matchers/catch_matchers_exception.hpp>  // Catch::Matchers::Message
+#elif (_CATCH_VERSION_MAJOR == 2)
+  #include <catch2/catch.hpp>
+#endif
+
+#include "safeLibcAsync.hh"
+
+#include <cstddef>   // size_t
+#include <string>
+#include <vector>
+#include <arpa/inet.h>   // htonl
+#include <fcntl.h>       // fcntl
+#include <netinet/in.h>  // sockaddr_in
+#include <sys/socket.h>  // socket, socketpair, bind, listen
+#include <unistd.h>      // close, pipe2
+
+
+#if (CATCH_VERSION_MAJOR > 2)
+using Catch::Matchers::Message;
+#else
+using Catch::Message;
+#endif
+
+namespace {
+
+Task<std::string> readExactly(EpollReactor& reactor, const int fd,
+                              const std::size_t len) {
+    std::string received(len, '\0');
+    for (std::size_t done { 0 }; done < len;) {
+        const ssize_t ct { co_await asyncRead(reactor, fd, received.data() + done,
+                                              len - done) };
+        if (ct == 0)
+            break;
+        done += static_cast<std::size_t>(ct);
+    }
+    co_return received;
+}
+
+Task<void> writeAll(EpollReactor& reactor, const int fd,
+                    const std::string msg) {
+    for (std::size_t done { 0 }; done < msg.size();) {
+        done += static_cast<std::size_t>(co_await asyncWrite(
+                reactor, fd, msg.data() + done, msg.size() - done));
+    }
+}
+
+// coroutine lambdas must not capture: the closure dies before the coroutine
+
+Task<void> readInto(EpollReactor& reactor, const int fd, const std::size_t len,
+                    std::string& received) {
+    received = co_await readExactly(reactor, fd, len);
+}
+
+sockaddr_in loopback(const in_port_t port) {
+    sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = port;
+    return addr;
+}
+
+}  // namespace
+
+TEST_CASE("Awaiting reads and writes on pipes",
+    "[EpollReactor, asyncRead, asyncWrite]")
+{
+    int fds[2];
+    REQUIRE(pipe2(fds, O_NONBLOCK | O_CLOEXEC) == 0);
+    // more than the pipe holds, so both sides must suspend
+    const std::string payload(256 * 1024, 'p');
+    std::string received;
+
+    EpollReactor reactor;
+    reactor.spawn(readInto(reactor, fds[0], payload.size(), received));
+    reactor.spawn(writeAll(reactor, fds[1], payload));
+    reactor.run();
+    REQUIRE(received == payload);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST_CASE("Multiplexing many socketpairs on one thread",
+    "[EpollReactor, asyncRecv, asyncSend]")
+{
+    constexpr std::size_t pair_ct { 200 };
+    constexpr int round_ct { 10 };
+    std::vector<int> ends;
+    for (std::size_t i { 0 }; i < pair_ct; ++i) {
+        int sv[2];
+        REQUIRE(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sv) == 0);
+        ends.push_back(sv[0]);
+        ends.push_back(sv[1]);
+    }
+
+    EpollReactor reactor;
+    std::size_t echoed_ct { 0 };
+    for (std::size_t i { 0 }; i < pair_ct; ++i) {
+        const int client { ends[2 * i] };
+        const int server { ends[2 * i + 1] };
+        // echo server, then client pinging it round_ct times
+        reactor.spawn([](EpollReactor& r, const int fd) -> Task<void> {
+            char buf[16];
+            for (ssize_t ct; (ct = co_await asyncRecv(r, fd, buf, sizeof(buf),
+                                                      0)) > 0;)
+                co_await asyncSend(r, fd, buf, static_cast<std::size_t>(ct), 0);
+        }(reactor, server));
+        reactor.spawn([](EpollReactor& r, const int fd, std::size_t& ct)
+                      -> Task<void> {
+            for (int round { 0 }; round < round_ct; ++round) {
+                const char ping { static_cast<char>('a' + round) };
+                co_await asyncSend(r, fd, &ping, 1, 0);
+                char pong { 0 };
+                co_await asyncRecv(r, fd, &pong, 1, 0);
+                ct += (pong == ping);
+            }
+            shutdown(fd, SHUT_WR);
+        }(reactor, client, echoed_ct));
+    }
+    reactor.run();
+    REQUIRE(echoed_ct == pair_ct * round_ct);
+    for (const int fd : ends)
+        close(fd);
+}
+
+TEST_CASE("Accepting and connecting loopback sockets",
+    "[EpollReactor, asyncAccept, asyncConnect]")
+{
+    const int listener { socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0) };
+    REQUIRE(listener >= 0);
+    sockaddr_in addr { loopback(0) };
+    REQUIRE(bind(listener, reinterpret_cast<sockaddr*>(&addr),
+                 sizeof(addr)) == 0);
+    REQUIRE(listen(listener, 8) == 0);
+    socklen_t addr_len { sizeof(addr) };
+    REQUIRE(getsockname(listener, reinterpret_cast<sockaddr*>(&addr),
+                        &addr_len) == 0);
+
+    SECTION("Exchange over an accepted connection")
+    {
+        std::string received;
+        EpollReactor reactor;
+        reactor.spawn([](EpollReactor& r, const int listen_fd,
+                         std::string& out) -> Task<void> {
+            const int conn { co_await asyncAccept(r, listen_fd) };
+            out = co_await readExactly(r, conn, 5);
+            close(conn);
+        }(reactor, listener, received));
+        reactor.spawn([](EpollReactor& r, const sockaddr_in to) -> Task<void> {
+            const int sock { socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0) };
+            co_await asyncConnect(r, sock,
+                                  reinterpret_cast<const sockaddr*>(&to),
+                                  sizeof(to));
+            co_await writeAll(r, sock, "hello");
+            close(sock);
+        }(reactor, addr));
+        reactor.run();
+        REQUIRE(received == "hello");
+    }
+    close(listener);
+
+    SECTION("Failures throw as safeLibcCall")
+    {
+        // the port is now closed
+        const int sock { socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0) };
+        EpollReactor reactor;
+        reactor.spawn(asyncConnect(reactor, sock,
+                                   reinterpret_cast<const sockaddr*>(&addr),
+                                   sizeof(addr)));
+        REQUIRE_THROWS_MATCHES(
+            reactor.run(),
+            std::system_error,
+            Message("connect: Connection refused")
+            );
+        close(sock);
+
+        reactor.spawn([](EpollReactor& r, const int fd) -> Task<void> {
+            char c;
+            co_await asyncRead(r, fd, &c, 1);
+        }(reactor, sock));
+        REQUIRE_THROWS_MATCHES(
+            reactor.run(),
+            std::system_error,
+            Message("read: Bad file descriptor")
+            );
+    }
+}
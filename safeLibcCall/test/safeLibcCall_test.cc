@@ -7,10 +7,27 @@
   #include <catch2/catch.hpp>
 #endif
 
+#include "safeLibcBatch.hh"
+#include "safeLibcBulk.hh"
 #include "safeLibcCall.hh"
+#include "safeLibcFile.hh"
+#include "safeLibcIo.hh"
 
-#include <fcntl.h>   // open
-#include <unistd.h>  // close, unlink
+#include <cerrno>    // EAGAIN, EINTR, ENOENT
+#include <chrono>
+#include <cstdio>    // fopen, fclose
+#if __cplusplus >= 202002L
+#include <source_location>
+#endif
+#include <stdexcept>  // runtime_error
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>  // is_trivially_copyable_v
+#include <vector>
+#include <fcntl.h>   // open, fcntl
+#include <unistd.h>  // close, pipe, unlink
+#include <sys/stat.h>  // stat
 
 
 #if (CATCH_VERSION_MAJOR > 2)
@@ -178,3 +195,713 @@ TEST_CASE("Detection by any non-zero errno with no test functor",
             );
     }
 }
+
+TEST_CASE("Detection by compile-time predicate policies",
+    "[ret_eq, ret_null, errno_nonzero, retTest, errTest, retErrTest]")
+{
+    SECTION("Success")
+    {
+        int fd { -1 };
+        REQUIRE_NOTHROW(
+            fd = safeLibcCall(open, "open", ret_eq<-1>{},
+                              _TFNAME, O_RDONLY | O_CREAT, 0644)
+            );
+        close(fd);
+        std::FILE* file { nullptr };
+        REQUIRE_NOTHROW(
+            file = safeLibcCall(std::fopen, "fopen", ret_null{},
+                                _TFNAME, "r")
+            );
+        if (file != nullptr)
+            std::fclose(file);
+        unlink(_TFNAME);
+    }
+    SECTION("Failure by return value")
+    {
+        REQUIRE_THROWS_MATCHES(
+            safeLibcCall(open, "open", ret_eq<-1>{},
+                         "", O_RDONLY),
+            std::system_error,
+            Message("open: No such file or directory")
+            );
+        REQUIRE_THROWS_MATCHES(
+            safeLibcCall(std::fopen, "fopen", ret_null{},
+                         "", "r"),
+            std::system_error,
+            Message("fopen: No such file or directory")
+            );
+        SECTION("errno not set")
+        {
+            int fd { -1 };
+            REQUIRE_THROWS_MATCHES(
+                fd = safeLibcCall(open, "open",
+                                  retTest([](const int ret) { return ret != -1; }),
+                                  _TFNAME, O_RDONLY | O_CREAT, 0644),
+                std::runtime_error,
+                Message("open: failure without setting errno")
+                );
+            close(fd);
+            unlink(_TFNAME);
+        }
+    }
+    SECTION("Failure by errno")
+    {
+        REQUIRE_THROWS_MATCHES(
+            safeLibcCall(open, "open", errno_nonzero{},
+                         "", O_RDONLY),
+            std::system_error,
+            Message("open: No such file or directory")
+            );
+        REQUIRE_THROWS_MATCHES(
+            safeLibcCall(open, "open",
+                         errTest([](const int err) { return err == ENOENT; }),
+                         "", O_RDONLY),
+            std::system_error,
+            Message("open: No such file or directory")
+            );
+    }
+    SECTION("Failure by return value and errno")
+    {
+        const auto open_test { retErrTest([](const int ret, const int err) {
+            return (ret == -1 || err);
+        }) };
+        REQUIRE_THROWS_MATCHES(
+            safeLibcCall(open, "open", open_test,
+                         "", O_RDONLY),
+            std::system_error,
+            Message("open: No such file or directory")
+            );
+    }
+    SECTION("Arguments are forwarded, not copied")
+    {
+        const auto count_into { [](int& count) { return ++count; } };
+        int count { 0 };
+        safeLibcCall(count_into, "count_into", ret_eq<-1>{}, count);
+        REQUIRE(count == 1);
+    }
+    SECTION("Predicates are stateless and need no std::function")
+    {
+        static_assert(std::is_empty_v<ret_eq<-1>>);
+        static_assert(std::is_empty_v<ret_null>);
+        static_assert(std::is_empty_v<errno_nonzero>);
+        const auto never { retTest([](int) { return false; }) };
+        static_assert(sizeof(never) == 1);
+        static_assert(!impl::is_libc_predicate_v<LibcRetTest<int>>);
+    }
+}
+
+namespace libc_name_test {
+
+int alwaysFails(int) {
+    errno = EBADF;
+    return -1;
+}
+
+}  // namespace libc_name_test
+
+TEST_CASE("Names taken from template arguments at compile time",
+    "[libcFuncName]")
+{
+    static_assert(libcFuncName<&open>() == "open");
+    static_assert(libcFuncName<&close>() == "close");
+    static_assert(libcFuncName<&libc_name_test::alwaysFails>() ==
+                  "libc_name_test::alwaysFails");
+
+    SECTION("safeLibcCall, with and without a predicate")
+    {
+        int fds[2];
+        REQUIRE(safeLibcCall<&pipe>(ret_eq<-1>{}, fds) == 0);
+        REQUIRE(safeLibcCall<&close>(fds[0]) == 0);
+        REQUIRE(safeLibcCall<&close>(ret_eq<-1>{}, fds[1]) == 0);
+        REQUIRE_THROWS_MATCHES(
+            safeLibcCall<&open>(ret_eq<-1>{}, "", O_RDONLY),
+            std::system_error,
+            Message("open: No such file or directory")
+            );
+        REQUIRE_THROWS_MATCHES(
+            safeLibcCall<&close>(-1),
+            std::system_error,
+            Message("close: Bad file descriptor")
+            );
+        REQUIRE_THROWS_MATCHES(
+            safeLibcCall<&libc_name_test::alwaysFails>(ret_eq<-1>{}, 0),
+            std::system_error,
+            Message("libc_name_test::alwaysFails: Bad file descriptor")
+            );
+    }
+#if __cplusplus >= 202002L
+    SECTION("safeLibcCall with a predicate, keeping the call site")
+    {
+        const std::source_location here { std::source_location::current() };
+        try {
+            safeLibcCall<&open>(ret_eq<-1>{}, "", O_RDONLY);  // here.line() + 2
+            FAIL("open of an empty path should throw");
+        } catch (const LibcError& e) {
+            REQUIRE(e.callSite().line() == here.line() + 2);
+            REQUIRE(std::string_view { e.callSite().file_name() } ==
+                    here.file_name());
+            REQUIRE(e.funcName() == "open");
+        }
+        // not known to the runtime-named overloads
+        try {
+            safeLibcCall(close, "close", ret_eq<-1>{}, -1);
+            FAIL("close of -1 should throw");
+        } catch (const LibcError& e) {
+            REQUIRE(e.callSite().line() == 0);
+        }
+    }
+#endif
+    SECTION("tryLibcCall, with and without a predicate")
+    {
+        const LibcResult<int> opened {
+            tryLibcCall<&open>(ret_eq<-1>{}, "", O_RDONLY) };
+        REQUIRE(!opened);
+        REQUIRE(opened.errnoValue() == ENOENT);
+        REQUIRE(opened.funcName() == "open");
+        const LibcResult<int> closed { tryLibcCall<&close>(-1) };
+        REQUIRE(closed.errnoValue() == EBADF);
+        REQUIRE(closed.funcName() == "close");
+        // names live in static storage, shared by every call
+        REQUIRE(closed.funcName().data() ==
+                tryLibcCall<&close>(-1).funcName().data());
+    }
+}
+
+TEST_CASE("Non-throwing calls with tryLibcCall",
+    "[tryLibcCall, LibcResult]")
+{
+    SECTION("Success")
+    {
+        const LibcResult<int> result {
+            tryLibcCall(open, "open", ret_eq<-1>{},
+                        _TFNAME, O_RDONLY | O_CREAT, 0644) };
+        REQUIRE(result.has_value());
+        REQUIRE(static_cast<bool>(result));
+        REQUIRE(!result.error());
+        REQUIRE(result.value() == *result);
+        close(*result);
+        unlink(_TFNAME);
+    }
+    SECTION("Failure by return value")
+    {
+        const LibcResult<int> result {
+            tryLibcCall(open, "open", ret_eq<-1>{}, "", O_RDONLY) };
+        REQUIRE(!result.has_value());
+        REQUIRE(*result == -1);
+        REQUIRE(result.errnoValue() == ENOENT);
+        REQUIRE(result.error() == std::errc::no_such_file_or_directory);
+        REQUIRE(result.error() ==
+                std::make_error_code(std::errc::no_such_file_or_directory));
+        REQUIRE(result.funcName() == "open");
+        REQUIRE(result.value_or(-2) == -2);
+        REQUIRE_THROWS_MATCHES(
+            result.value(),
+            std::system_error,
+            Message("open: No such file or directory")
+            );
+    }
+    SECTION("Failure by errno, without predicate")
+    {
+        const auto result { tryLibcCall(open, "open", "", O_RDONLY) };
+        REQUIRE(!result);
+        REQUIRE(result.error() == std::errc::no_such_file_or_directory);
+    }
+    SECTION("Failure without setting errno")
+    {
+        const auto fail_quietly { [](const int ret) { return ret; } };
+        const auto result { tryLibcCall(fail_quietly, "fail_quietly",
+                                        ret_eq<-1>{}, -1) };
+        REQUIRE(!result);
+        REQUIRE(!result.error());
+        REQUIRE_THROWS_MATCHES(
+            result.value(),
+            std::runtime_error,
+            Message("fail_quietly: failure without setting errno")
+            );
+    }
+    SECTION("Routine failures can be handled without exceptions")
+    {
+        const auto would_block { []() { errno = EAGAIN; return -1; } };
+        int again_ct { 0 };
+        for (int i { 0 }; i < 100; ++i) {
+            const auto result { tryLibcCall(would_block, "would_block",
+                                            ret_eq<-1>{}) };
+            if (result.error() == std::errc::resource_unavailable_try_again)
+                ++again_ct;
+        }
+        REQUIRE(again_ct == 100);
+        static_assert(std::is_trivially_copyable_v<LibcResult<int>>);
+    }
+}
+
+TEST_CASE("Retry policies for EINTR and EAGAIN",
+    "[retry_eintr, retry_eagain, safeLibcCallRetry]")
+{
+    SECTION("EINTR is retried until success")
+    {
+        int call_ct { 0 };
+        const auto interrupted_twice { [&call_ct]() {
+            if (++call_ct <= 2) { errno = EINTR; return -1; }
+            return 0;
+        } };
+        REQUIRE(safeLibcCallRetry(retry_eintr{}, interrupted_twice,
+                                  "interrupted_twice", ret_eq<-1>{}) == 0);
+        REQUIRE(call_ct == 3);
+    }
+    SECTION("Other failures are not retried, and throw as safeLibcCall")
+    {
+        int call_ct { 0 };
+        const auto fail_enoent { [&call_ct]() {
+            ++call_ct; errno = ENOENT; return -1;
+        } };
+        REQUIRE_THROWS_MATCHES(
+            safeLibcCallRetry(retry_eagain{}, fail_enoent, "fail_enoent",
+                              ret_eq<-1>{}),
+            std::system_error,
+            Message("fail_enoent: No such file or directory")
+            );
+        REQUIRE(call_ct == 1);
+        const auto result { tryLibcCallRetry(retry_eintr{}, fail_enoent,
+                                             "fail_enoent", ret_eq<-1>{}) };
+        REQUIRE(result.errnoValue() == ENOENT);
+        REQUIRE(call_ct == 2);
+    }
+    SECTION("EAGAIN is spun on, then waited out with bounded polling")
+    {
+        int fds[2];
+        REQUIRE(pipe(fds) == 0);
+        fcntl(fds[0], F_SETFL, O_NONBLOCK);
+        char c { 0 };
+        std::thread writer { [&fds]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            write(fds[1], "x", 1);
+        } };
+        REQUIRE(safeLibcCallRetry(retry_eagain{ fds[0], POLLIN },
+                                  read, "read", ret_eq<-1>{},
+                                  fds[0], &c, 1) == 1);
+        writer.join();
+        REQUIRE(c == 'x');
+
+        const auto start { std::chrono::steady_clock::now() };
+        REQUIRE_THROWS_MATCHES(
+            safeLibcCallRetry(retry_eagain{ fds[0], POLLIN, 4, 30 },
+                              read, "read", ret_eq<-1>{}, fds[0], &c, 1),
+            std::system_error,
+            Message("read: Resource temporarily unavailable")
+            );
+        REQUIRE(std::chrono::steady_clock::now() - start >=
+                std::chrono::milliseconds(30));
+        close(fds[0]);
+        close(fds[1]);
+    }
+}
+
+TEST_CASE("Completing short transfers",
+    "[readAll, writeAll, readvAll, writevAll]")
+{
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    // larger than the default pipe capacity of 64KiB, forcing short transfers
+    constexpr std::size_t payload_sz { 200 * 1024 };
+    std::string payload(payload_sz, '\0');
+    for (std::size_t i { 0 }; i < payload_sz; ++i)
+        payload[i] = static_cast<char>('a' + i % 26);
+    std::string received(payload_sz, '\0');
+
+    SECTION("readAll and writeAll, blocking")
+    {
+        std::thread writer { [&]() {
+            writeAll(fds[1], payload.data(), payload_sz);
+            close(fds[1]);
+        } };
+        REQUIRE(readAll(fds[0], received.data(), payload_sz) == payload_sz);
+        writer.join();
+        REQUIRE(received == payload);
+        // short only at end of file
+        REQUIRE(readAll(fds[0], received.data(), payload_sz) == 0);
+    }
+    SECTION("readAll and writeAll, nonblocking")
+    {
+        fcntl(fds[0], F_SETFL, O_NONBLOCK);
+        fcntl(fds[1], F_SETFL, O_NONBLOCK);
+        std::thread writer { [&]() {
+            writeAll(fds[1], payload.data(), payload_sz, retry_eagain{});
+            close(fds[1]);
+        } };
+        REQUIRE(readAll(fds[0], received.data(), payload_sz,
+                        retry_eagain{}) == payload_sz);
+        writer.join();
+        REQUIRE(received == payload);
+    }
+    SECTION("readvAll and writevAll, buffers split mid-transfer")
+    {
+        std::size_t wrote { 0 };
+        std::thread writer { [&]() {
+            wrote = writevAll(fds[1], {
+                    { payload.data(), 7 },
+                    { payload.data() + 7, payload_sz / 2 },
+                    { payload.data() + 7 + payload_sz / 2,
+                      payload_sz - 7 - payload_sz / 2 } });
+            close(fds[1]);
+        } };
+        const iovec iov[] {
+            { received.data(), payload_sz / 3 },
+            { received.data() + payload_sz / 3, payload_sz - payload_sz / 3 },
+            { nullptr, 0 } };
+        REQUIRE(readvAll(fds[0], iov, 3) == payload_sz);
+        writer.join();
+        REQUIRE(wrote == payload_sz);
+        REQUIRE(received == payload);
+    }
+    close(fds[0]);
+
+    SECTION("Failures throw as safeLibcCall")
+    {
+        close(fds[1]);
+        char c;
+        REQUIRE_THROWS_MATCHES(
+            readAll(fds[0], &c, 1),
+            std::system_error,
+            Message("read: Bad file descriptor")
+            );
+        const iovec iov { &c, 1 };
+        REQUIRE_THROWS_MATCHES(
+            writevAll(fds[1], &iov, 1),
+            std::system_error,
+            Message("writev: Bad file descriptor")
+            );
+    }
+}
+
+TEST_CASE("Batched calls with LibcBatch",
+    "[LibcBatch]")
+{
+    std::vector<LibcBatchBackend> backends { LibcBatchBackend::ThreadPool };
+    if (LibcBatch{}.backend() == LibcBatchBackend::IoUring)
+        backends.push_back(LibcBatchBackend::IoUring);
+    // more files than queue slots, to run in several rounds
+    constexpr std::size_t file_ct { 20 };
+    constexpr unsigned queue_depth { 8 };
+    std::vector<std::string> paths;
+    for (std::size_t i { 0 }; i < file_ct; ++i)
+        paths.push_back(_TFNAME + std::to_string(i));
+
+    for (const LibcBatchBackend backend : backends) {
+        LibcBatch batch { queue_depth, backend };
+        REQUIRE(batch.backend() == backend);
+
+        // open for writing, plus one failure that must not stop the rest
+        for (const std::string& path : paths) {
+            batch.openat(AT_FDCWD, path.c_str(),
+                         O_RDWR | O_CREAT | O_TRUNC, 0644);
+        }
+        const std::size_t missing { batch.openat(AT_FDCWD, "", O_RDONLY) };
+        REQUIRE(batch.size() == file_ct + 1);
+        const std::vector<LibcBatch::Result> opened { batch.submit() };
+        REQUIRE(batch.size() == 0);
+        REQUIRE(opened.size() == file_ct + 1);
+        REQUIRE(!opened[missing]);
+        REQUIRE(opened[missing].error() == std::errc::no_such_file_or_directory);
+        REQUIRE_THROWS_MATCHES(
+            opened[missing].value(),
+            std::system_error,
+            Message("openat: No such file or directory")
+            );
+        std::vector<int> fds;
+        for (std::size_t i { 0 }; i < file_ct; ++i) {
+            REQUIRE(opened[i]);
+            fds.push_back(static_cast<int>(opened[i].value()));
+        }
+
+        for (std::size_t i { 0 }; i < file_ct; ++i)
+            batch.write(fds[i], paths[i].data(), paths[i].size(), 0);
+        for (const LibcBatch::Result& wrote : batch.submit())
+            REQUIRE(wrote.value() > 0);
+
+        std::vector<std::string> contents(file_ct, std::string(64, '\0'));
+        std::vector<struct statx> stats(file_ct);
+        for (std::size_t i { 0 }; i < file_ct; ++i) {
+            batch.read(fds[i], contents[i].data(), 64, 0);
+            batch.statx(fds[i], "", AT_EMPTY_PATH, STATX_SIZE, &stats[i]);
+        }
+        const std::vector<LibcBatch::Result> read { batch.submit() };
+        for (std::size_t i { 0 }; i < file_ct; ++i) {
+            REQUIRE(read[2 * i].value() ==
+                    static_cast<ssize_t>(paths[i].size()));
+            contents[i].resize(paths[i].size());
+            REQUIRE(contents[i] == paths[i]);
+            REQUIRE(read[2 * i + 1].value() == 0);
+            REQUIRE(stats[i].stx_size == paths[i].size());
+        }
+
+        for (const int fd : fds)
+            batch.close(fd);
+        const std::size_t bad_close { batch.close(-1) };
+        const std::vector<LibcBatch::Result> closed { batch.submit() };
+        for (std::size_t i { 0 }; i < file_ct; ++i)
+            REQUIRE(closed[i]);
+        REQUIRE(closed[bad_close].errnoValue() == EBADF);
+        REQUIRE(closed[bad_close].funcName() == "close");
+    }
+    for (const std::string& path : paths)
+        unlink(path.c_str());
+}
+
+TEST_CASE("Exceptions built from the interned errno message table",
+    "[LibcError]")
+{
+    SECTION("Catchable as std::system_error, with the usual message and code")
+    {
+        try {
+            safeLibcCall(open, "open", ret_eq<-1>{}, "", O_RDONLY);
+            FAIL("no exception");
+        } catch (const std::system_error& e) {
+            REQUIRE(std::string_view(e.what()) ==
+                    "open: No such file or directory");
+            REQUIRE(e.code() == std::errc::no_such_file_or_directory);
+            REQUIRE(e.code() ==
+                    std::make_error_code(std::errc::no_such_file_or_directory));
+            REQUIRE(e.code().value() == ENOENT);
+            REQUIRE(e.code().message() == "No such file or directory");
+            REQUIRE(dynamic_cast<const LibcError*>(&e) != nullptr);
+            REQUIRE(dynamic_cast<const LibcError&>(e).funcName() == "open");
+        }
+    }
+    SECTION("Names need not be null-terminated")
+    {
+        const std::string_view name { std::string_view("opening").substr(0, 4) };
+        const LibcErrTest is_set { [](const int err) { return err != 0; } };
+        REQUIRE_THROWS_MATCHES(
+            safeLibcCall(open, name, "", O_RDONLY),
+            std::system_error,
+            Message("open: No such file or directory")
+            );
+        REQUIRE_THROWS_MATCHES(
+            safeLibcCall(open, name, is_set, "", O_RDONLY),
+            std::system_error,
+            Message("open: No such file or directory")
+            );
+    }
+    SECTION("Long names are truncated")
+    {
+        const std::string name(100, 'n');
+        const LibcError e { name, EBADF };
+        REQUIRE(e.funcName() == name.substr(0, 64));
+        REQUIRE(std::string_view(e.what()) ==
+                name.substr(0, 64) + ": Bad file descriptor");
+    }
+    SECTION("Every errno has a message")
+    {
+        for (int err { 1 }; err < 134; ++err) {
+            const LibcError e { "f", err };
+            REQUIRE(e.code().message() ==
+                    std::system_category().message(err));
+            REQUIRE(std::string_view(e.what()) ==
+                    "f: " + std::system_category().message(err));
+        }
+    }
+}
+
+TEST_CASE("Parallel calls over argument ranges with bulkLibcCall",
+    "[bulkLibcCall]")
+{
+    SECTION("Every index is visited once, whatever the size and thread count")
+    {
+        for (const unsigned thread_ct : { 1u, 2u, 3u, 8u }) {
+            LibcWorkPool pool { thread_ct };
+            REQUIRE(pool.threadCount() == thread_ct);
+            for (const std::size_t n : { 0u, 1u, 7u, 100u, 1000u }) {
+                for (const std::size_t grain : { 1u, 16u }) {
+                    std::vector<int> visits(n, 0);
+                    pool.parallelFor(n, [&](const std::size_t i) {
+                        ++visits[i]; }, grain);
+                    for (const int visit_ct : visits)
+                        REQUIRE(visit_ct == 1);
+                }
+            }
+        }
+    }
+    SECTION("The first exception is rethrown after the rest of the loop")
+    {
+        LibcWorkPool pool { 4 };
+        std::vector<int> visits(200, 0);
+        REQUIRE_THROWS_AS(
+            pool.parallelFor(visits.size(), [&](const std::size_t i) {
+                ++visits[i];
+                if (i % 50 == 0)
+                    throw std::runtime_error("failed");
+            }, 1),
+            std::runtime_error
+            );
+        for (const int visit_ct : visits)
+            REQUIRE(visit_ct == 1);
+        // and the pool is still usable
+        pool.parallelFor(visits.size(), [&](const std::size_t i) {
+            ++visits[i]; });
+        for (const int visit_ct : visits)
+            REQUIRE(visit_ct == 2);
+    }
+    SECTION("Tuples of arguments, with failures collected per element")
+    {
+        constexpr std::size_t file_ct { 40 };
+        std::vector<std::string> paths;
+        for (std::size_t i { 0 }; i < file_ct; ++i) {
+            paths.push_back(_TFNAME + std::to_string(i));
+            // every fourth file missing
+            if (i % 4 != 0)
+                std::fclose(std::fopen(paths.back().c_str(), "w"));
+        }
+        std::vector<struct stat> stats(file_ct);
+        std::vector<const char*> names;
+        std::vector<std::tuple<const char*, struct stat*>> args;
+        for (std::size_t i { 0 }; i < file_ct; ++i) {
+            names.push_back(paths[i].c_str());
+            args.emplace_back(names.back(), &stats[i]);
+        }
+
+        const LibcBulkResult<int> stated {
+            bulkLibcCall(stat, "stat", ret_eq<-1>{}, args, 4) };
+        REQUIRE(stated.size() == file_ct);
+        REQUIRE(stated.failureCount() == file_ct / 4);
+        REQUIRE(stated.errnoCounts().size() == 1);
+        REQUIRE(stated.errnoCounts().at(ENOENT) == file_ct / 4);
+        for (std::size_t i { 0 }; i < file_ct; ++i) {
+            REQUIRE(static_cast<bool>(stated[i]) == (i % 4 != 0));
+            if (stated[i])
+                REQUIRE(stats[i].st_size == 0);
+        }
+        REQUIRE_THROWS_MATCHES(
+            stated.throwIfFailed(),
+            std::system_error,
+            Message("stat: No such file or directory")
+            );
+
+        LibcWorkPool pool { 2 };
+        const LibcBulkResult<int> unlinked {
+            bulkLibcCall(pool, unlink, "unlink", ret_eq<-1>{}, names) };
+        REQUIRE(unlinked.failureCount() == file_ct / 4);
+    }
+    SECTION("Single arguments, and a range of successes")
+    {
+        std::vector<int> fds;
+        for (int i { 0 }; i < 10; ++i) {
+            int pipe_fds[2];
+            REQUIRE(pipe(pipe_fds) == 0);
+            fds.push_back(pipe_fds[0]);
+            fds.push_back(pipe_fds[1]);
+        }
+        const LibcBulkResult<int> closed {
+            bulkLibcCall(close, "close", ret_eq<-1>{}, fds, 3) };
+        REQUIRE(closed.failureCount() == 0);
+        REQUIRE(closed.errnoCounts().empty());
+        REQUIRE_NOTHROW(closed.throwIfFailed());
+        for (const LibcResult<int>& result : *closed)
+            REQUIRE(result.value() == 0);
+    }
+}
+
+TEST_CASE("Owning fds and mappings with UniqueFd and MappedFile",
+    "[UniqueFd][MappedFile]")
+{
+    SECTION("UniqueFd closes what it owns, once")
+    {
+        int pipe_fds[2];
+        REQUIRE(pipe(pipe_fds) == 0);
+        {
+            UniqueFd read_end { pipe_fds[0] };
+            UniqueFd write_end { pipe_fds[1] };
+            UniqueFd moved { std::move(read_end) };
+            REQUIRE(!read_end);
+            REQUIRE(moved.get() == pipe_fds[0]);
+            write_end = std::move(moved);
+            // the write end was closed by the assignment
+            REQUIRE(fcntl(pipe_fds[1], F_GETFD) == -1);
+            REQUIRE(write_end.get() == pipe_fds[0]);
+            REQUIRE(write_end.release() == pipe_fds[0]);
+            REQUIRE(!write_end);
+            write_end.reset(pipe_fds[0]);
+        }
+        REQUIRE(fcntl(pipe_fds[0], F_GETFD) == -1);
+    }
+    SECTION("UniqueFd opens with O_CLOEXEC, and throws on failure")
+    {
+        const UniqueFd fd { _TFNAME, O_WRONLY | O_CREAT | O_TRUNC, 0644 };
+        REQUIRE(fd);
+        REQUIRE((fcntl(fd.get(), F_GETFD) & FD_CLOEXEC) != 0);
+        REQUIRE(unlink(_TFNAME) == 0);
+        REQUIRE_THROWS_MATCHES(
+            UniqueFd(_TFNAME, O_RDONLY),
+            std::system_error,
+            Message("open: No such file or directory")
+            );
+    }
+    SECTION("MappedFile maps the whole file, with any options")
+    {
+        // a few pages and a partial one
+        std::string contents;
+        for (int i { 0 }; contents.size() < 3 * 4096 + 100; ++i)
+            contents += std::to_string(i) + ',';
+        {
+            const UniqueFd fd { _TFNAME, O_WRONLY | O_CREAT | O_TRUNC, 0644 };
+            writeAll(fd.get(), contents.data(), contents.size());
+        }
+        const MapOptions options[] {
+            {}, { true, false, false, false, false },
+            { false, true, true, false, true },
+            { true, true, true, true, true } };
+        for (const MapOptions& option : options) {
+            const MappedFile mapped { _TFNAME, option };
+            REQUIRE(mapped.size() == contents.size());
+            REQUIRE(mapped.view() == contents);
+            REQUIRE(static_cast<char>(mapped.data()[5]) == contents[5]);
+#if __cplusplus >= 202002L
+            REQUIRE(mapped.bytes().size() == contents.size());
+            REQUIRE(mapped.bytes().data() == mapped.data());
+#endif
+            REQUIRE_NOTHROW(mapped.advise(MapAdvice::Random, 5000, 100));
+            REQUIRE_NOTHROW(mapped.advise(MapAdvice::Normal));
+            REQUIRE_NOTHROW(mapped.prefault());
+        }
+
+        MappedFile mapped { UniqueFd{ _TFNAME, O_RDONLY }.get() };
+        const std::byte* const data { mapped.data() };
+        MappedFile moved { std::move(mapped) };
+        REQUIRE(mapped.empty());
+        REQUIRE(mapped.data() == nullptr);
+        REQUIRE(moved.data() == data);
+        REQUIRE(moved.view() == contents);
+        REQUIRE_THROWS_MATCHES(
+            moved.advise(static_cast<MapAdvice>(-1)),
+            std::system_error,
+            Message("madvise: Invalid argument")
+            );
+        REQUIRE(unlink(_TFNAME) == 0);
+    }
+    SECTION("Empty files map nothing; failures throw")
+    {
+        std::fclose(std::fopen(_TFNAME, "w"));
+        const MappedFile mapped { _TFNAME };
+        REQUIRE(mapped.empty());
+        REQUIRE(mapped.data() == nullptr);
+        REQUIRE(mapped.view().empty());
+        REQUIRE_NOTHROW(mapped.prefault());
+        REQUIRE(unlink(_TFNAME) == 0);
+
+        REQUIRE_THROWS_MATCHES(
+            MappedFile(_TFNAME),
+            std::system_error,
+            Message("open: No such file or directory")
+            );
+        REQUIRE_THROWS_MATCHES(
+            MappedFile(-1),
+            std::system_error,
+            Message("fstat: Bad file descriptor")
+            );
+        int pipe_fds[2];
+        REQUIRE(pipe(pipe_fds) == 0);
+        const UniqueFd read_end { pipe_fds[0] }, write_end { pipe_fds[1] };
+        REQUIRE(write(pipe_fds[1], "x", 1) == 1);
+        // a pipe has no size, so maps as empty
+        REQUIRE(MappedFile(pipe_fds[0]).empty());
+    }
+}
@@ -0,0 +1,142 @@
+#if (_CATCH_VERSION_MAJOR == 3)
+  #include <catch2/catch_version_macros.hpp>               // CATCH_VERSION_MAJOR
+  #include <catch2/catch_test_macros.hpp>                  // TEST_CASE, SECTION, REQUIRE
+#elif (_CATCH_VERSION_MAJOR == 2)
+  #include <catch2/catch.hpp>
+#endif
+
+// also set for the target, as every translation unit must agree
+#ifndef SAFELIBCCALL_INSTRUMENT
+#define SAFELIBCCALL_INSTRUMENT
+#endif
+#include "safeLibcCall.hh"
+#include "safeLibcStats.hh"
+
+#include <cerrno>    // ENOENT
+#include <cstdint>   // uint64_t
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <fcntl.h>   // open
+#include <unistd.h>  // close, getpid
+
+
+namespace {
+
+const LibcCallStats* findStats(const std::vector<LibcCallStats>& snapshot,
+                               const std::string_view name) {
+    for (const LibcCallStats& s : snapshot) {
+        if (s.name == name)
+            return &s;
+    }
+    return nullptr;
+}
+
+int succeed(const int val) { return val; }
+
+}  // namespace
+
+TEST_CASE("Latency buckets",
+    "[safeLibcStats]")
+{
+    for (std::uint64_t ns { 0 }; ns < (std::uint64_t{ 1 } << 40);
+         ns = ns * 5 / 4 + 1) {
+        const std::size_t bucket { impl::latencyBucket(ns) };
+        REQUIRE(bucket < impl::latency_bucket_ct);
+        REQUIRE(impl::latencyBucketLow(bucket) <= ns);
+        REQUIRE(ns < impl::latencyBucketLow(bucket + 1));
+        // within 12.5%
+        REQUIRE(ns - impl::latencyBucketLow(bucket) <= ns / 8);
+    }
+    REQUIRE(impl::latencyBucket(~std::uint64_t{ 0 }) ==
+            impl::latency_bucket_ct - 1);
+}
+
+TEST_CASE("Recording calls and failures by name",
+    "[safeLibcStats]")
+{
+    for (int i { 0 }; i < 10; ++i)
+        close(safeLibcCall(open, "open(stats)", ret_eq<-1>{}, "/", O_RDONLY));
+    for (int i { 0 }; i < 3; ++i) {
+        REQUIRE_THROWS(safeLibcCall(open, "open(stats)", ret_eq<-1>{}, "",
+                                    O_RDONLY));
+    }
+    const auto result { tryLibcCall(open, "open(stats)", ret_eq<-1>{}, "",
+                                    O_RDONLY) };
+    // recording leaves errno as the call did
+    REQUIRE(errno == ENOENT);
+    REQUIRE(result.errnoValue() == ENOENT);
+    const LibcRetTest<int> is_neg { [](const int ret) { return ret < 0; } };
+    safeLibcCall(succeed, "succeed(stats)", is_neg, 1);
+
+    const std::vector<LibcCallStats> snapshot { libcStatsSnapshot() };
+    const LibcCallStats* const opens { findStats(snapshot, "open(stats)") };
+    REQUIRE(opens != nullptr);
+    REQUIRE(opens->call_ct == 14);
+    REQUIRE(opens->fail_ct == 4);
+    REQUIRE(opens->errno_cts.size() == 1);
+    REQUIRE(opens->errno_cts.at(ENOENT) == 4);
+    std::uint64_t bucketed { 0 };
+    for (const std::uint64_t ct : opens->latency_cts)
+        bucketed += ct;
+    REQUIRE(bucketed == 14);
+    REQUIRE(opens->percentileNs(0.5) <= opens->percentileNs(0.99));
+    REQUIRE(opens->percentileNs(0.99) <= opens->max_ns);
+    const LibcCallStats* const succeeds { findStats(snapshot, "succeed(stats)") };
+    REQUIRE(succeeds != nullptr);
+    REQUIRE(succeeds->call_ct == 1);
+    REQUIRE(succeeds->fail_ct == 0);
+
+    std::ostringstream text;
+    libcStatsDumpText(text, snapshot);
+    REQUIRE(text.str().find("open(stats): calls 14, failures 4") !=
+            std::string::npos);
+    std::ostringstream json;
+    libcStatsDumpJson(json, snapshot);
+    REQUIRE(json.str().find("\"name\": \"open(stats)\", \"calls\": 14, "
+                            "\"failures\": 4") != std::string::npos);
+    REQUIRE(json.str().find("\"errno\": {\"2\": 4}") != std::string::npos);
+}
+
+TEST_CASE("Recording calls with empty names",
+    "[safeLibcStats]")
+{
+    // on a new thread, so that its name cache starts empty
+    std::thread { []() {
+        safeLibcCall(getpid, std::string_view {}, ret_eq<-1>{});
+        safeLibcCall(getpid, "", ret_eq<-1>{});
+    } }.join();
+    const std::vector<LibcCallStats> snapshot { libcStatsSnapshot() };
+    const LibcCallStats* const unnamed { findStats(snapshot, "") };
+    REQUIRE(unnamed != nullptr);
+    REQUIRE(unnamed->call_ct == 2);
+}
+
+TEST_CASE("Merging across live and exited threads",
+    "[safeLibcStats]")
+{
+    constexpr int thread_ct { 4 };
+    constexpr int call_ct { 1000 };
+    std::vector<std::thread> threads;
+    for (int t { 0 }; t < thread_ct; ++t) {
+        threads.emplace_back([]() {
+            for (int i { 0 }; i < call_ct; ++i)
+                safeLibcCall(succeed, "succeed(threads)", ret_eq<-1>{}, i);
+        });
+    }
+    // merging while threads record must be safe, if not yet complete
+    const LibcCallStats* partial { nullptr };
+    const std::vector<LibcCallStats> during { libcStatsSnapshot() };
+    partial = findStats(during, "succeed(threads)");
+    if (partial != nullptr)
+        REQUIRE(partial->call_ct <= thread_ct * call_ct);
+    for (std::thread& t : threads)
+        t.join();
+    safeLibcCall(succeed, "succeed(threads)", ret_eq<-1>{}, 0);
+
+    const std::vector<LibcCallStats> after { libcStatsSnapshot() };
+    const LibcCallStats* const merged { findStats(after, "succeed(threads)") };
+    REQUIRE(merged != nullptr);
+    REQUIRE(merged->call_ct == thread_ct * call_ct + 1);
+}
@@ -0,0 +1,188 @@
+/*
+ * Runs a compile command several times, reporting its median wall and CPU
+ *   time and peak memory, and tracks regressions against earlier runs:
+ *
+ *   compile_bench_runner [--runs N] [--history FILE] [--window N]
+ *       [--tolerance PCT] LABEL -- COMMAND...
+ *
+ *   With --history, results are compared with the median of the last
+ *   --window (default 5) results for LABEL in FILE; the exit status is 1 if
+ *   CPU time or memory grew by more than PCT percent (default 10). Only
+ *   results within tolerance are appended, so that repeated runs of a
+ *   regression do not become the median they are compared with; a deliberate
+ *   increase is accepted by removing LABEL's lines from FILE. Medians, of the
+ *   runs (default 5) and of the history, keep one slow run or one unusually
+ *   fast earlier result from failing unchanged code. CPU time (user + sys, of
+ *   the compiler and its children) is compared rather than wall time, as it is
+ *   less disturbed by other load.
+ *
+ *   Shared by the compile_bench targets of typeName and IsStreamable.
+ */
+
+#include <algorithm>  // max, nth_element
+#include <chrono>
+#include <cstddef>    // ptrdiff_t, size_t
+#include <cstdio>     // fprintf, printf
+#include <cstdlib>    // atof, atoi
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>  // rusage
+#include <sys/wait.h>      // wait4, WEXITSTATUS, WIFEXITED
+#include <unistd.h>        // execvp, fork, _exit
+
+
+namespace {
+
+struct Measurement {
+    double wall_s { 0 };
+    double cpu_s { 0 };
+    long max_rss_kb { 0 };
+};
+
+double seconds(const timeval& tv) {
+    return static_cast<double>(tv.tv_sec) +
+        static_cast<double>(tv.tv_usec) / 1e6;
+}
+
+// false if the command could not be run or failed
+bool runOnce(char* const* argv, Measurement& run) {
+    const auto start { std::chrono::steady_clock::now() };
+    const pid_t pid { fork() };
+    if (pid == -1)
+        return false;
+    if (pid == 0) {
+        execvp(argv[0], argv);
+        _exit(127);
+    }
+    int status;
+    rusage usage {};
+    if (wait4(pid, &status, 0, &usage) == -1)
+        return false;
+    const auto stop { std::chrono::steady_clock::now() };
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return false;
+    run.wall_s = std::chrono::duration<double>(stop - start).count();
+    run.cpu_s = seconds(usage.ru_utime) + seconds(usage.ru_stime);
+    run.max_rss_kb = usage.ru_maxrss;
+    return true;
+}
+
+// upper median, of a copy
+template <typename T>
+T median(std::vector<T> vals) {
+    const auto mid {
+        vals.begin() + static_cast<std::ptrdiff_t>(vals.size() / 2) };
+    std::nth_element(vals.begin(), mid, vals.end());
+    return *mid;
+}
+
+// each field's median across `runs`
+Measurement medianOf(const std::vector<Measurement>& runs) {
+    std::vector<double> wall, cpu;
+    std::vector<long> rss;
+    for (const Measurement& run : runs) {
+        wall.push_back(run.wall_s);
+        cpu.push_back(run.cpu_s);
+        rss.push_back(run.max_rss_kb);
+    }
+    return { median(wall), median(cpu), median(rss) };
+}
+
+// median of the last `window` earlier results labeled `label`
+bool recentEarlier(const std::string& history_path, const std::string& label,
+                   const std::size_t window, Measurement& earlier) {
+    std::ifstream history { history_path };
+    std::deque<Measurement> recent;
+    for (std::string line; std::getline(history, line);) {
+        std::istringstream fields { line };
+        std::string run_label;
+        Measurement run;
+        if (!(fields >> run_label >> run.wall_s >> run.cpu_s >> run.max_rss_kb) ||
+            run_label != label)
+            continue;
+        recent.push_back(run);
+        if (recent.size() > window)
+            recent.pop_front();
+    }
+    if (recent.empty())
+        return false;
+    earlier = medianOf({ recent.begin(), recent.end() });
+    return true;
+}
+
+double percentChange(const double before, const double after) {
+    return before > 0 ? (after - before) / before * 100 : 0;
+}
+
+int usage(const char* argv0) {
+    std::fprintf(stderr, "usage: %s [--runs N] [--history FILE] [--window N] "
+                 "[--tolerance PCT] LABEL -- COMMAND...\n", argv0);
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int run_ct { 5 };
+    std::string history_path;
+    int window { 5 };
+    double tolerance_pct { 10 };
+    std::string label;
+    int i { 1 };
+    for (; i < argc && std::string { argv[i] } != "--"; ++i) {
+        const std::string arg { argv[i] };
+        if (arg == "--runs" && i + 1 < argc)
+            run_ct = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--history" && i + 1 < argc)
+            history_path = argv[++i];
+        else if (arg == "--window" && i + 1 < argc)
+            window = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--tolerance" && i + 1 < argc)
+            tolerance_pct = std::atof(argv[++i]);
+        else if (label.empty())
+            label = arg;
+        else
+            return usage(argv[0]);
+    }
+    if (label.empty() || i + 1 >= argc)
+        return usage(argv[0]);
+    char* const* const command { argv + i + 1 };
+
+    std::vector<Measurement> runs(static_cast<std::size_t>(run_ct));
+    for (Measurement& run : runs) {
+        if (!runOnce(command, run)) {
+            std::fprintf(stderr, "%s: compile command failed\n", label.c_str());
+            return 1;
+        }
+    }
+    const Measurement result { medianOf(runs) };
+    std::printf("%-32s %8.2f s wall %8.2f s cpu %10ld KB (median of %d)\n",
+                label.c_str(), result.wall_s, result.cpu_s, result.max_rss_kb,
+                run_ct);
+    if (history_path.empty())
+        return 0;
+
+    Measurement earlier;
+    if (recentEarlier(history_path, label, static_cast<std::size_t>(window),
+                      earlier)) {
+        const double cpu_change { percentChange(earlier.cpu_s, result.cpu_s) };
+        const double rss_change {
+            percentChange(static_cast<double>(earlier.max_rss_kb),
+                          static_cast<double>(result.max_rss_kb)) };
+        std::printf("%-32s %+7.1f%% cpu %+7.1f%% memory vs median of recent "
+                    "runs\n", "", cpu_change, rss_change);
+        if (cpu_change > tolerance_pct || rss_change > tolerance_pct) {
+            std::printf("%-32s REGRESSION beyond %.1f%%, not recorded\n", "",
+                        tolerance_pct);
+            return 1;
+        }
+    }
+    std::ofstream { history_path, std::ios::app } << label << '\t' <<
+        result.wall_s << '\t' << result.cpu_s << '\t' << result.max_rss_kb <<
+        '\n';
+    return 0;
+}
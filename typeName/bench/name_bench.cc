@@ -0,0 +1,41 @@
+/*
+ * Compares repeated typeName calls on the pre-C++17 path, which returns each
+ *   type's name cached on first use, with building the name on every call
+ *   (demangling and appending qualifiers, as typeName did before caching).
+ */
+
+#include "typeName.hh"
+#include "benchUtils.hh"
+
+#include <cstddef>   // size_t
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+constexpr std::size_t call_ct { 1 << 18 };
+
+}  // namespace
+
+int main() {
+    printResult("build per call, int", nsPerOp([](std::size_t n) {
+        for (std::size_t i { 0 }; i < n; ++i)
+            doNotOptimize(impl::makeTypeName<int>().size());
+    }, call_ct));
+    printResult("cached, int", nsPerOp([](std::size_t n) {
+        for (std::size_t i { 0 }; i < n; ++i)
+            doNotOptimize(typeName<int>().size());
+    }, call_ct));
+
+    using Nested = const std::map<std::string, std::vector<int>>&;
+    printResult("build per call, const map<...>&", nsPerOp([](std::size_t n) {
+        for (std::size_t i { 0 }; i < n; ++i)
+            doNotOptimize(impl::makeTypeName<Nested>().size());
+    }, call_ct));
+    printResult("cached, const map<...>&", nsPerOp([](std::size_t n) {
+        for (std::size_t i { 0 }; i < n; ++i)
+            doNotOptimize(typeName<Nested>().size());
+    }, call_ct));
+}
@@ -0,0 +1,52 @@
+/*
+ * Instantiates typeNameCstr for TYPE_CT distinct types (rounded up to a
+ *   multiple of 64), to measure the compile time and memory per type name,
+ *   as compiled by the compile_bench target with TYPE_CT set by the
+ *   TYPENAME_COMPILE_BENCH_TYPE_CT cache variable. With
+ *   WITH_STRING defined, each type's name includes std::string, which under
+ *   g++ takes the slower path erasing the inline namespace `__cxx11`.
+ */
+
+#include "typeName.hh"
+
+#include <cstddef>   // size_t
+#include <cstdio>    // puts
+#include <string>
+#include <utility>   // index_sequence, pair
+
+#ifndef TYPE_CT
+#define TYPE_CT 1024
+#endif
+
+
+namespace {
+
+constexpr std::size_t block_sz { 64 };
+
+template <std::size_t N>
+struct Tag {};
+
+#ifdef WITH_STRING
+template <std::size_t N>
+using Named = std::pair<Tag<N>, std::string>;
+#else
+template <std::size_t N>
+using Named = Tag<N>;
+#endif
+
+// in blocks, as one fold over thousands of calls compiles in quadratic time
+template <std::size_t Block, std::size_t ...Is>
+void putBlock(std::index_sequence<Is...>) {
+    (std::puts(typeNameCstr<Named<Block * block_sz + Is>>()), ...);
+}
+
+template <std::size_t ...Blocks>
+void putNames(std::index_sequence<Blocks...>) {
+    (putBlock<Blocks>(std::make_index_sequence<block_sz> {}), ...);
+}
+
+}  // namespace
+
+int main() {
+    putNames(std::make_index_sequence<(TYPE_CT + block_sz - 1) / block_sz> {});
+}
@@ -0,0 +1,74 @@
+/*
+ * Compares dispatch by type among 16 types through an unordered_map keyed by
+ *   std::type_index with dispatch by typeId through a TypeMap.
+ */
+
+#include "typeName.hh"
+#include "typeRegistry.hh"
+#include "benchUtils.hh"
+
+#include <array>
+#include <cstddef>   // size_t
+#include <cstdint>   // uint64_t
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>   // index_sequence
+
+
+namespace {
+
+constexpr std::size_t lookup_ct { 1 << 24 };
+
+template <std::size_t N>
+struct Message {};
+
+using Handler = int (*)(int);
+
+template <std::size_t N>
+int handle(const int val) { return val + static_cast<int>(N); }
+
+template <std::size_t ...Is>
+TypeMap<Handler, Message<Is>...> makeTypeMap(std::index_sequence<Is...>) {
+    return TypeMap<Handler, Message<Is>...> { &handle<Is>... };
+}
+
+template <std::size_t ...Is>
+std::unordered_map<std::type_index, Handler> makeIndexMap(
+    std::index_sequence<Is...>) {
+    return { { std::type_index(typeid(Message<Is>)), &handle<Is> }... };
+}
+
+template <std::size_t ...Is>
+std::array<std::uint64_t, sizeof...(Is)> makeIds(std::index_sequence<Is...>) {
+    return { { typeId<Message<Is>>()... } };
+}
+
+template <std::size_t ...Is>
+std::array<std::type_index, sizeof...(Is)> makeIndices(
+    std::index_sequence<Is...>) {
+    return { { std::type_index(typeid(Message<Is>))... } };
+}
+
+}  // namespace
+
+int main() {
+    constexpr std::make_index_sequence<16> types {};
+    const auto type_map { makeTypeMap(types) };
+    const auto index_map { makeIndexMap(types) };
+    const auto ids { makeIds(types) };
+    const auto indices { makeIndices(types) };
+
+    printResult("unordered_map<type_index> lookup", nsPerOp([&](std::size_t n) {
+        int sum { 0 };
+        for (std::size_t i { 0 }; i < n; ++i)
+            sum = index_map.find(indices[i % indices.size()])->second(sum);
+        doNotOptimize(sum);
+    }, lookup_ct));
+    printResult("TypeMap lookup by typeId", nsPerOp([&](std::size_t n) {
+        int sum { 0 };
+        for (std::size_t i { 0 }; i < n; ++i)
+            sum = (*type_map.find(ids[i % ids.size()]))(sum);
+        doNotOptimize(sum);
+    }, lookup_ct));
+}
@@ -22,8 +22,10 @@
 #include <string>
 #include <cstdlib>      // free
 
+namespace impl {
+
 /*
- * @brief Returns string of a data type name as it would be printed by the
+ * @brief Builds string of a data type name as it would be printed by the
  *   compiler in error messages.
  *
  * @notes `typeid(obj).name()` return is implementation-dependent; with g++
@@ -39,7 +41,7 @@
  *   - https://www.cplusplus.com/forum/beginner/175177/#msg866884
  */
 template <class T>
-std::string typeName(void) {
+std::string makeTypeName(void) {
     typedef typename std::remove_reference<T>::type TR;
 #    ifndef _MSC_VER
     std::unique_ptr<char, void(*)(void*)> demangled (
@@ -61,6 +63,22 @@ std::string typeName(void) {
     return result;
 }
 
+}  // namespace impl
+
+/*
+ * @brief Returns string of a data type name as it would be printed by the
+ *   compiler in error messages.
+ *
+ * @notes Demangling allocates, so each type's name is built once, on first
+ *   use (thread-safely, as a function-local static), and then returned by
+ *   reference.
+ */
+template <class T>
+const std::string& typeName(void) {
+    static const std::string name { impl::makeTypeName<T>() };
+    return name;
+}
+
 #else   // C++17 and above
 
 /*
@@ -70,7 +88,11 @@ std::string typeName(void) {
  * As an upgade to the C++11 version, this solution will resolve at compile time.
  */
 
+#include <array>
+#include <cstddef>      // size_t
+#include <cstdint>      // uint64_t
 #include <string_view>
+#include <utility>      // index_sequence
 
 namespace impl {
 
@@ -124,26 +146,373 @@ constexpr TypeNameFormat type_name_format {
 static_assert(type_name_format.prefix_sz != std::string_view::npos,
               "Unable to determine the type name format on this compiler.");
 
+/*
+ * @brief Type name as the compiler wrote it, within the output of rawTypeName.
+ */
+template <typename T>
+constexpr std::string_view compilerTypeName() {
+    constexpr std::string_view raw_tn { rawTypeName<T>() };
+    return raw_tn.substr(
+        type_name_format.prefix_sz,
+        raw_tn.size() - type_name_format.total_extra_chars
+        );
+}
+
+constexpr bool isIdentChar(const char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+        (c >= '0' && c <= '9') || c == '_' || c == '$';
+}
+
+constexpr bool isDroppedKeyword(const std::string_view token) {
+    // MSVC elaborated type specifiers and calling conventions
+    return token == "class" || token == "struct" || token == "enum" ||
+        token == "union" || token == "__cdecl" || token == "__stdcall" ||
+        token == "__fastcall" || token == "__vectorcall" ||
+        token == "__thiscall" || token == "__ptr64";
+}
+
+/*
+ * @brief Lexes a type name as written by the compiler into identifiers (and
+ *   numbers) and single punctuation characters, skipping spaces.
+ */
+class TypeNameLexer {
+public:
+    constexpr explicit TypeNameLexer(const std::string_view name) :
+        name { name } {}
+
+    constexpr bool done() { skipSpaces(); return pos == name.size(); }
+
+    constexpr std::string_view next() {
+        skipSpaces();
+        // anonymous namespaces as clang and MSVC write them
+        constexpr std::string_view clang_anon { "(anonymous namespace)" };
+        constexpr std::string_view msvc_anon { "`anonymous namespace'" };
+        if (name.substr(pos, clang_anon.size()) == clang_anon ||
+            name.substr(pos, msvc_anon.size()) == msvc_anon) {
+            pos += clang_anon.size();
+            return "{anonymous}";
+        }
+        const std::size_t start { pos };
+        if (!isIdentChar(name[pos]))
+            return name.substr(pos++, 1);
+        while (pos < name.size() && isIdentChar(name[pos]))
+            ++pos;
+        return name.substr(start, pos - start);
+    }
+
+    /*
+     * @brief Whether the next token is `*` or `&`, or `*` after a class name
+     *   and `::`, as in the declarators of pointers (to members) to functions
+     *   or arrays, eg "(*)" or "(S::*)"; calling conventions are skipped.
+     */
+    constexpr bool declaratorFollows() {
+        skipSpaces();
+        std::size_t i { pos };
+        for (;;) {
+            std::size_t end { i };
+            while (end < name.size() && isIdentChar(name[end]))
+                ++end;
+            if (end == i || !isDroppedKeyword(name.substr(i, end - i)))
+                break;
+            for (i = end; i < name.size() && name[i] == ' '; ++i) {}
+        }
+        if (i < name.size() && (name[i] == '*' || name[i] == '&'))
+            return true;
+        while (i < name.size() && (isIdentChar(name[i]) || name[i] == ':'))
+            ++i;
+        return i >= pos + 3 && i < name.size() && name[i] == '*' &&
+            name[i - 1] == ':' && name[i - 2] == ':';
+    }
+
+    /*
+     * @brief Whether the next tokens are `void )`, as in MSVC's and C-style
+     *   empty parameter lists, "(void)".
+     */
+    constexpr bool voidParamsFollow() {
+        skipSpaces();
+        constexpr std::string_view void_kw { "void" };
+        if (name.substr(pos, void_kw.size()) != void_kw)
+            return false;
+        std::size_t i { pos + void_kw.size() };
+        while (i < name.size() && name[i] == ' ')
+            ++i;
+        return i < name.size() && name[i] == ')';
+    }
+
+    constexpr std::string_view peek() {
+        const std::size_t saved_pos { pos };
+        const std::string_view token { next() };
+        pos = saved_pos;
+        return token;
+    }
+
+private:
+    constexpr void skipSpaces() {
+        while (pos < name.size() && name[pos] == ' ')
+            ++pos;
+    }
+
+    std::string_view name;
+    std::size_t pos { 0 };
+};
+
+constexpr bool isIntegralKeyword(const std::string_view token) {
+    return token == "signed" || token == "unsigned" || token == "short" ||
+        token == "long" || token == "int" || token == "char" ||
+        token == "double" || token == "__int64";
+}
+
+/*
+ * @brief Integer literal without its `u`, `l` or `ll` suffix, eg "3" for
+ *   MSVC's "3UL", as g++ writes non-type template arguments.
+ */
+constexpr std::string_view withoutLiteralSuffix(std::string_view literal) {
+    while (literal.size() > 1 &&
+           (literal.back() == 'u' || literal.back() == 'U' ||
+            literal.back() == 'l' || literal.back() == 'L'))
+        literal.remove_suffix(1);
+    return literal;
+}
+
+/*
+ * @brief Spelling g++ uses for a run of integral (and `long double`)
+ *   keywords, eg "long unsigned int" for clang's "unsigned long", or MSVC's
+ *   "unsigned long" (equally long) and "unsigned __int64".
+ */
+constexpr std::string_view canonicalIntegral(TypeNameLexer& lexer,
+                                             std::string_view token) {
+    bool is_signed { false }, is_unsigned { false }, is_short { false };
+    bool is_char { false }, is_double { false };
+    int long_ct { 0 };
+    for (;;) {
+        is_signed |= token == "signed";
+        is_unsigned |= token == "unsigned";
+        is_short |= token == "short";
+        is_char |= token == "char";
+        is_double |= token == "double";
+        long_ct += token == "long" ? 1 : token == "__int64" ? 2 : 0;
+        if (lexer.done() || !isIntegralKeyword(lexer.peek()))
+            break;
+        token = lexer.next();
+    }
+    if (is_double)
+        return long_ct > 0 ? "long double" : "double";
+    if (is_char)
+        return is_signed ? "signed char" :
+            is_unsigned ? "unsigned char" : "char";
+    if (is_short)
+        return is_unsigned ? "short unsigned int" : "short int";
+    if (long_ct == 1)
+        return is_unsigned ? "long unsigned int" : "long int";
+    if (long_ct >= 2)
+        return is_unsigned ? "long long unsigned int" : "long long int";
+    return is_unsigned ? "unsigned int" : "int";
+}
+
+/*
+ * @brief Passes to `out` the pieces of `name` rewritten in the form g++
+ *   uses, whichever compiler wrote it: spacing as g++ spaces, integral types
+ *   spelled as g++ spells them, `(void)` parameter lists as `()`, integer
+ *   literals without suffixes, and without MSVC's `class`/`struct`/`enum`/
+ *   `union` and calling conventions, or the inline namespaces `__cxx11` and
+ *   `__1` of libstdc++ and libc++.
+ *
+ * @notes Default template arguments, which MSVC writes out, are kept, as are
+ *   the names of lambdas and other unnamed types, which differ by compiler.
+ *   Qualifiers are not reordered, so a compiler writing `int const` rather
+ *   than `const int` gives a different name; nor are non-type template
+ *   arguments beyond literal suffixes, which compilers write differently (eg
+ *   g++ `S<f>` for clang `S<&f>`, and MSVC integers in hexadecimal).
+ */
+template <typename OutFunc>
+constexpr void canonicalizeTypeName(const std::string_view name,
+                                    OutFunc&& out) {
+    TypeNameLexer lexer { name };
+    std::string_view prev {};
+    std::string_view before_prev {};
+    // after a parameter list, among its cv-, ref- and noexcept qualifiers
+    bool in_fn_quals { false };
+    while (!lexer.done()) {
+        std::string_view token { lexer.next() };
+        if (isDroppedKeyword(token))
+            continue;
+        if ((token == "__cxx11" || token == "__1") && lexer.peek() == ":") {
+            lexer.next();
+            lexer.next();
+            continue;
+        }
+        if (token == "(" && lexer.voidParamsFollow())
+            lexer.next();
+        if (isIntegralKeyword(token))
+            token = canonicalIntegral(lexer, token);
+        else if (token.front() >= '0' && token.front() <= '9')
+            token = withoutLiteralSuffix(token);
+        if (!prev.empty()) {
+            const char p { prev.back() };
+            const char t { token.front() };
+            // address-of in a template argument list, eg "S<&f>"
+            const bool unary { prev == "&" &&
+                (before_prev == "<" || before_prev == ",") };
+            const bool space {
+                (isIdentChar(p) && isIdentChar(t)) ||
+                p == ',' ||
+                (p == '>' && t == '>') ||
+                ((p == '*' || p == '&') && isIdentChar(t) && !unary) ||
+                (p == ')' && isIdentChar(t)) ||
+                (in_fn_quals && t == '&' && p != '&') ||
+                (t == '[' && p != ')' && p != ']') ||
+                (t == '(' && p != '(' && p != '<' && p != ':' &&
+                 lexer.declaratorFollows())
+            };
+            if (space)
+                out(std::string_view { " " });
+        }
+        out(token);
+        in_fn_quals = token == ")" ||
+            (in_fn_quals && (isIdentChar(token.front()) || token == "&"));
+        before_prev = prev;
+        prev = token;
+    }
+}
+
+/*
+ * @brief Passes to `out`, as pointer and size, the pieces of `name` outside
+ *   the inline namespaces `__cxx11::` and `__1::`.
+ *
+ * @notes Here and in isCanonical, characters are compared through a raw
+ *   pointer: each call of string_view's operator[], substr or find is a
+ *   separate constant evaluation, which costs g++ more than the comparison.
+ */
+template <typename OutFunc>
+constexpr void eraseInlineNamespaces(const std::string_view name,
+                                     OutFunc&& out) {
+    const char* const chars { name.data() };
+    const std::size_t size { name.size() };
+    std::size_t start { 0 };
+    for (std::size_t i { 0 }; i + 5 <= size; ++i) {
+        if (chars[i] != '_' || chars[i + 1] != '_' ||
+            (i > 0 && isIdentChar(chars[i - 1])))
+            continue;
+        std::size_t ns_sz { 0 };
+        if (i + 9 <= size && chars[i + 2] == 'c' && chars[i + 3] == 'x' &&
+            chars[i + 4] == 'x' && chars[i + 5] == '1' && chars[i + 6] == '1' &&
+            chars[i + 7] == ':' && chars[i + 8] == ':')
+            ns_sz = 9;  // "__cxx11::"
+        else if (chars[i + 2] == '1' && chars[i + 3] == ':' &&
+                 chars[i + 4] == ':')
+            ns_sz = 5;  // "__1::"
+        if (ns_sz == 0)
+            continue;
+        out(chars + start, i - start);
+        start = i + ns_sz;
+        i = start - 1;
+    }
+    out(chars + start, size - start);
+}
+
+/*
+ * @brief Whether a name as the compiler wrote it is already canonical.
+ *
+ * @notes g++ writes names canonically but for inline namespaces, so under g++
+ *   only names with a `__` need rewriting, and then only by
+ *   eraseInlineNamespaces; as canonicalizeTypeName costs g++ around 10ms of
+ *   compile time per name, it is used only under other compilers.
+ */
+constexpr bool isCanonical(const std::string_view name) {
+#    if defined(__GNUC__) && !defined(__clang__)
+    const char* const chars { name.data() };
+    for (std::size_t i { 1 }; i < name.size(); ++i) {
+        if (chars[i] == '_' && chars[i - 1] == '_')
+            return false;
+    }
+    return true;
+#    else
+    static_cast<void>(name);
+    return false;
+#    endif
+}
+
+/*
+ * @brief Fixed-capacity output of canonicalizeTypeName.
+ */
+template <std::size_t Capacity>
+struct TypeNameBuffer {
+    char chars[Capacity] {};
+    std::size_t size { 0 };
+
+    constexpr void operator()(const char* const piece,
+                              const std::size_t piece_sz) {
+        for (std::size_t i { 0 }; i < piece_sz; ++i)
+            chars[size++] = piece[i];
+    }
+
+    constexpr void operator()(const std::string_view piece) {
+        (*this)(piece.data(), piece.size());
+    }
+};
+
+/*
+ * @brief Canonical name of T, computed only for names not already canonical.
+ *
+ * @notes Capacity is twice the compiler's name, as canonicalizing lengthens
+ *   no token more than twofold ("long" to "long int", "," to ", ").
+ */
+template <typename T>
+constexpr auto canonicalTypeNameBuffer() {
+    TypeNameBuffer<compilerTypeName<T>().size() * 2> buffer {};
+#    if defined(__GNUC__) && !defined(__clang__)
+    eraseInlineNamespaces(compilerTypeName<T>(), buffer);
+#    else
+    canonicalizeTypeName(compilerTypeName<T>(), buffer);
+#    endif
+    return buffer;
+}
+
+template <typename T>
+constexpr std::size_t canonicalTypeNameSize() {
+    if constexpr (isCanonical(compilerTypeName<T>()))
+        return compilerTypeName<T>().size();
+    else
+        return canonicalTypeNameBuffer<T>().size;
+}
+
+/*
+ * @brief Copies the canonical name of T by pack expansion, which compiles
+ *   faster than a loop, null-terminated.
+ */
+template <typename T, std::size_t ...Is>
+constexpr std::array<char, sizeof...(Is) + 1> copyTypeName(
+    std::index_sequence<Is...>) {
+    if constexpr (isCanonical(compilerTypeName<T>())) {
+        // built-in subscripts, sparing an operator[] call per character
+        constexpr const char* name { compilerTypeName<T>().data() };
+        return { { name[Is]..., '\0' } };
+    } else {
+        constexpr auto buffer { canonicalTypeNameBuffer<T>() };
+        return { { buffer.chars[Is]..., '\0' } };
+    }
+}
+
 /*
  * @brief Making the result static to save re-evaluating for successive calls
- *   with the same data type.
+ *   with the same data type; stored null-terminated, so as a C-string too.
  */
+template <typename T>
+static constexpr std::array<char, canonicalTypeNameSize<T>() + 1>
+type_name_chars {
+    copyTypeName<T>(std::make_index_sequence<canonicalTypeNameSize<T>()> {})
+};
+
 template <typename T>
 static constexpr std::string_view type_name_storage {
-    []() constexpr {
-        constexpr std::string_view raw_tn { rawTypeName<T>() };
-        return raw_tn.substr(
-            type_name_format.prefix_sz,
-            raw_tn.size() - type_name_format.total_extra_chars
-            );
-    }()
+    type_name_chars<T>.data(), type_name_chars<T>.size() - 1
 };
 
 }  // namespace impl
 
 /*
- * @brief Returns string_view of a data type name as it would be printed by the
- *   compiler in error messages.
+ * @brief Returns string_view of a data type name as it would be printed by
+ *   g++ in error messages, whichever compiler is used.
  */
 template <typename T>
 [[nodiscard]] constexpr std::string_view typeName() {
@@ -151,12 +520,47 @@ template <typename T>
 }
 
 /*
- * @brief Returns C-string of a data type name as it would be printed by the
- *   compiler in error messages.
+ * @brief Returns null-terminated C-string of a data type name as it would be
+ *   printed by g++ in error messages, whichever compiler is used.
  */
 template <typename T>
 [[nodiscard]] constexpr const char *typeNameCstr() {
-    return impl::type_name_storage<T>.data();
+    return impl::type_name_chars<T>.data();
+}
+
+namespace impl {
+
+/*
+ * @brief 64-bit FNV-1a hash, see:
+ *   - http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ */
+constexpr std::uint64_t fnv1a64(const std::string_view str) {
+    std::uint64_t hash { 0xcbf29ce484222325 };
+    for (const char c : str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+template <typename T>
+static constexpr std::uint64_t type_id_storage {
+    fnv1a64(type_name_storage<T>)
+};
+
+}  // namespace impl
+
+/*
+ * @brief Returns a 64-bit ID for a data type: the FNV-1a hash of its name, so
+ *   the same in every build, and needing no RTTI; with names canonicalized,
+ *   the same across compilers too for types whose canonical names agree,
+ *   which excludes those named with east const, lambdas, MSVC's written-out
+ *   default template arguments or most non-type template arguments (see
+ *   canonicalizeTypeName).
+ */
+template <typename T>
+[[nodiscard]] constexpr std::uint64_t typeId() {
+    return impl::type_id_storage<T>;
 }
 
 #endif  // C++17 and above
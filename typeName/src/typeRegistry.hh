@@ -0,0 +1,230 @@
+#ifndef TYPEREGISTRY_HH
+#define TYPEREGISTRY_HH
+
+
+#if __cplusplus < 201703L
+
+#error "typeRegistry.hh requires compilation as C++17 or higher"
+
+#else   // C++17 and above
+
+/*
+ * Compile-time perfect hashing of the typeId values of a list of types, to
+ *   look types up by ID with one multiply and one indexed load, in place of
+ *   maps keyed by std::type_index.
+ */
+
+#include "typeName.hh"  // typeId
+
+#include <array>
+#include <cstddef>      // size_t
+#include <cstdint>      // uint64_t
+#include <type_traits>  // is_same_v
+#include <utility>      // index_sequence
+
+namespace impl {
+
+/*
+ * @brief Multiplicative hash of IDs into 2^(64 - shift) slots, by the top bits
+ *   of id * multiplier.
+ */
+struct PerfectHash {
+    std::uint64_t multiplier { 0 };
+    unsigned shift { 63 };
+    std::size_t slot_ct { 0 };  // 0 if no perfect hash was found
+
+    constexpr std::size_t slot(const std::uint64_t id) const {
+        return static_cast<std::size_t>((id * multiplier) >> shift);
+    }
+};
+
+constexpr std::uint64_t splitMix64(std::uint64_t& state) {
+    std::uint64_t z { state += 0x9e3779b97f4a7c15 };
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+/*
+ * @brief Searches multipliers, for the smallest power-of-2 slot count that
+ *   has one, for a hash mapping each of `ids` to a distinct slot.
+ *
+ * @notes Tables grow until a multiplier is found within `attempt_ct`
+ *   attempts, typically to around N^2/8 slots for N IDs, at most 2^max_bits.
+ */
+template <std::size_t N>
+constexpr PerfectHash findPerfectHash(const std::array<std::uint64_t, N>& ids) {
+    constexpr unsigned max_bits { 16 };
+    constexpr unsigned attempt_ct { 512 };
+    std::array<std::uint64_t, (std::size_t { 1 } << max_bits) / 64> used {};
+    unsigned bits { 1 };
+    while ((std::size_t { 1 } << bits) < N)
+        ++bits;
+    for (; bits <= max_bits; ++bits) {
+        std::uint64_t state { bits };
+        for (unsigned attempt { 0 }; attempt < attempt_ct; ++attempt) {
+            const PerfectHash hash {
+                splitMix64(state) | 1, 64 - bits, std::size_t { 1 } << bits };
+            std::size_t placed_ct { 0 };
+            for (; placed_ct < N; ++placed_ct) {
+                const std::size_t slot { hash.slot(ids[placed_ct]) };
+                const std::uint64_t bit { std::uint64_t { 1 } << (slot % 64) };
+                if (used[slot / 64] & bit)
+                    break;
+                used[slot / 64] |= bit;
+            }
+            for (std::size_t i { 0 }; i < placed_ct; ++i) {
+                const std::size_t slot { hash.slot(ids[i]) };
+                used[slot / 64] &= ~(std::uint64_t { 1 } << (slot % 64));
+            }
+            if (placed_ct == N)
+                return hash;
+        }
+    }
+    return {};
+}
+
+// ValueType, once per type in a pack expansion over Types
+template <typename ValueType, typename>
+using value_for_t = ValueType;
+
+template <std::size_t N>
+constexpr bool allDistinct(const std::array<std::uint64_t, N>& ids) {
+    for (std::size_t i { 0 }; i < N; ++i) {
+        for (std::size_t j { i + 1 }; j < N; ++j) {
+            if (ids[i] == ids[j])
+                return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace impl
+
+template <typename ValueType, typename ...Types>
+class TypeMap;
+
+/*
+ * @brief Perfect hash of the typeId values of `Types`, mapping each ID to the
+ *   index of its type in `Types`, all computed at compile time.
+ */
+template <typename ...Types>
+class TypeRegistry {
+public:
+    static constexpr std::size_t type_ct { sizeof...(Types) };
+    static constexpr std::size_t npos { static_cast<std::size_t>(-1) };
+
+    /*
+     * @brief Returns the index in `Types` of the type with ID `type_id`, or
+     *   npos if none of `Types` has it.
+     */
+    static constexpr std::size_t indexOf(const std::uint64_t type_id) {
+        const Slot& slot { slots[hash.slot(type_id)] };
+        return slot.type_id == type_id ? slot.index : npos;
+    }
+
+    template <typename T>
+    static constexpr std::size_t indexOf() { return indexOf(typeId<T>()); }
+
+    static constexpr bool contains(const std::uint64_t type_id) {
+        return indexOf(type_id) != npos;
+    }
+
+    // size of the hash table, a power of 2
+    static constexpr std::size_t slotCount() { return hash.slot_ct; }
+
+private:
+    template <typename ValueType, typename ...MapTypes>
+    friend class TypeMap;
+
+    struct Slot {
+        std::uint64_t type_id { 0 };
+        std::size_t index { npos };  // npos for unused slots
+    };
+
+    static constexpr std::array<std::uint64_t, type_ct> ids {
+        { typeId<Types>()... } };
+    static_assert(impl::allDistinct(ids),
+                  "Types must be distinct, with distinct typeId values.");
+
+    static constexpr impl::PerfectHash hash { impl::findPerfectHash(ids) };
+    static_assert(hash.slot_ct != 0,
+                  "Unable to find a perfect hash for these types.");
+
+    static constexpr std::array<Slot, hash.slot_ct> slots {
+        []() constexpr {
+            std::array<Slot, hash.slot_ct> result {};
+            for (std::size_t i { 0 }; i < type_ct; ++i)
+                result[hash.slot(ids[i])] = Slot { ids[i], i };
+            return result;
+        }()
+    };
+};
+
+/*
+ * @brief Maps each of `Types` to a value, eg a handler or serializer, stored
+ *   in the slots of TypeRegistry<Types...>, so that find() is one multiply and
+ *   one indexed load (plus a compare of the ID).
+ *
+ * @notes ValueType must be default-constructible, to fill unused slots, and
+ *   copyable.
+ */
+template <typename ValueType, typename ...Types>
+class TypeMap {
+public:
+    using Registry = TypeRegistry<Types...>;
+
+    // one value per type, in the order of `Types`
+    constexpr explicit TypeMap(
+        const impl::value_for_t<ValueType, Types>& ...values) :
+        entries { makeEntries(
+            std::array<ValueType, sizeof...(Types)> { { values... } },
+            std::make_index_sequence<Registry::hash.slot_ct> {}) } {}
+
+    /*
+     * @brief Returns the value for the type with ID `type_id`, or null if
+     *   none of `Types` has it.
+     */
+    constexpr const ValueType* find(const std::uint64_t type_id) const {
+        const Entry& entry { entries[Registry::hash.slot(type_id)] };
+        return entry.type_id == type_id && entry.used ? &entry.value : nullptr;
+    }
+
+    template <typename T>
+    constexpr const ValueType& get() const {
+        static_assert(((std::is_same_v<T, Types>) || ...),
+                      "T must be one of the mapped types.");
+        return *find(typeId<T>());
+    }
+
+private:
+    struct Entry {
+        std::uint64_t type_id { 0 };
+        bool used { false };
+        ValueType value {};
+    };
+
+    template <std::size_t ...SlotIs>
+    static constexpr std::array<Entry, sizeof...(SlotIs)> makeEntries(
+        const std::array<ValueType, sizeof...(Types)>& values,
+        std::index_sequence<SlotIs...>) {
+        return { { makeEntry(values, SlotIs)... } };
+    }
+
+    static constexpr Entry makeEntry(
+        const std::array<ValueType, sizeof...(Types)>& values,
+        const std::size_t slot) {
+        const auto& registry_slot { Registry::slots[slot] };
+        if (registry_slot.index == Registry::npos)
+            return Entry {};
+        return Entry { registry_slot.type_id, true,
+                       values[registry_slot.index] };
+    }
+
+    std::array<Entry, Registry::hash.slot_ct> entries;
+};
+
+#endif  // C++17 and above
+
+
+#endif  // TYPEREGISTRY_HH
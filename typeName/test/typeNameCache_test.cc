@@ -0,0 +1,24 @@
+#if (_CATCH_VERSION_MAJOR == 3)
+  //#include <catch2/catch_version_macros.hpp>  // CATCH_VERSION_MAJOR
+  #include <catch2/catch_test_macros.hpp>     // TEST_CASE, SECTION, REQUIRE
+#elif (_CATCH_VERSION_MAJOR == 2)
+  #include <catch2/catch.hpp>
+#endif
+
+#include "typeName.hh"
+
+#include <string>
+
+TEST_CASE("Names cached before C++17",
+          "[cache]")
+{
+    static_assert(__cplusplus < 201703L, "built as C++14 by test/CMakeLists.txt");
+
+    SECTION("Each type's name is built once and returned by reference")
+    {
+        const std::string& name { typeName<const int&>() };
+        REQUIRE(&typeName<const int&>() == &name);
+        REQUIRE(name == impl::makeTypeName<const int&>());
+        REQUIRE(&typeName<int>() != &name);
+    }
+}
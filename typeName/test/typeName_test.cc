@@ -7,6 +7,9 @@
 
 #include "typeName.hh"
 
+#include <string>
+#include <string_view>
+
 TEST_CASE("C++ fundamental types",
           "[builtin]")
 {
@@ -142,3 +145,98 @@ TEST_CASE("Output of `decltype`",
         }
     }
 }
+
+#if __cplusplus >= 201703L
+namespace {
+
+std::string canonical(const std::string_view name) {
+    std::string result;
+    impl::canonicalizeTypeName(name, [&result](const std::string_view piece) {
+        result += piece; });
+    return result;
+}
+
+struct Local {};
+
+}  // namespace
+
+TEST_CASE("Null-terminated names, canonical across compilers",
+          "[canonical]")
+{
+    SECTION("C-strings end with the name")
+    {
+        static_assert(typeNameCstr<const int* const>()[16] == '\0');
+        REQUIRE(std::string_view(typeNameCstr<unsigned long>()) ==
+                "long unsigned int");
+        REQUIRE(std::string_view(typeNameCstr<std::string>()) ==
+                typeName<std::string>());
+        REQUIRE(typeNameCstr<int>() == typeName<int>().data());
+    }
+    SECTION("Inline namespaces of standard libraries are dropped")
+    {
+        REQUIRE(typeName<std::string>() == "std::basic_string<char>");
+        REQUIRE(canonical("std::__1::basic_string<char>") ==
+                "std::basic_string<char>");
+    }
+    SECTION("Anonymous namespaces as g++ writes them")
+    {
+        REQUIRE(typeName<Local>() == "{anonymous}::Local");
+        REQUIRE(canonical("(anonymous namespace)::Local") ==
+                "{anonymous}::Local");
+        REQUIRE(canonical("`anonymous namespace'::Local") ==
+                "{anonymous}::Local");
+    }
+    SECTION("Integral types as g++ spells them")
+    {
+        REQUIRE(canonical("unsigned long") == "long unsigned int");
+        REQUIRE(canonical("unsigned short") == "short unsigned int");
+        REQUIRE(canonical("long long") == "long long int");
+        REQUIRE(canonical("unsigned long long") == "long long unsigned int");
+        REQUIRE(canonical("__int64") == "long long int");
+        REQUIRE(canonical("unsigned __int64") == "long long unsigned int");
+        REQUIRE(canonical("signed") == "int");
+        REQUIRE(canonical("unsigned char") == "unsigned char");
+        REQUIRE(canonical("long double") == "long double");
+        REQUIRE(canonical("const unsigned long *") ==
+                "const long unsigned int*");
+        REQUIRE(canonical("char16_t") == "char16_t");
+    }
+    SECTION("Spacing as g++ spaces")
+    {
+        // clang
+        REQUIRE(canonical("const int *const") == "const int* const");
+        REQUIRE(canonical("int &&") == "int&&");
+        REQUIRE(canonical("std::vector<std::vector<int>>") ==
+                "std::vector<std::vector<int> >");
+        REQUIRE(canonical("int[3]") == "int [3]");
+        REQUIRE(canonical("int (&)[3]") == "int (&)[3]");
+        REQUIRE(canonical("int (S::*)(int)") == "int (S::*)(int)");
+        REQUIRE(canonical("void (int &)") == "void(int&)");
+        REQUIRE(canonical("void (S::*)() const") == "void (S::*)() const");
+        REQUIRE(canonical("void (S::*)() const &") == "void (S::*)() const &");
+        REQUIRE(canonical("void () &&") == "void() &&");
+        REQUIRE(canonical("S<&f>") == "S<&f>");
+        REQUIRE(canonical("S<1, &S::f>") == "S<1, &S::f>");
+        // MSVC
+        REQUIRE(canonical("class std::map<int,struct S>") ==
+                "std::map<int, S>");
+        REQUIRE(canonical("int(__cdecl*)(int,char)") == "int (*)(int, char)");
+        REQUIRE(canonical("enum E*const") == "E* const");
+        REQUIRE(canonical("int S::*") == "int S::*");
+        REQUIRE(canonical("void (__cdecl *)(void)") == "void (*)()");
+        REQUIRE(canonical("int (void *)") == "int(void*)");
+        REQUIRE(canonical("struct S<3UL,-1ll>") == "S<3, -1>");
+    }
+    SECTION("Names as g++ writes them are unchanged")
+    {
+        for (const std::string_view name : {
+                "std::map<int, std::vector<int> >", "int (*)(int, char)",
+                "int [2][3]", "int* [3]", "main()::<lambda()>",
+                "std::function<void(int*)>", "const volatile int&",
+                "void (S::*)() const &", "void() noexcept", "S<(& g)>",
+                "S<&S::f>" }) {
+            REQUIRE(canonical(name) == name);
+        }
+    }
+}
+#endif  // C++17 and above
@@ -0,0 +1,111 @@
+#if (_CATCH_VERSION_MAJOR == 3)
+  //#include <catch2/catch_version_macros.hpp>  // CATCH_VERSION_MAJOR
+  #include <catch2/catch_test_macros.hpp>     // TEST_CASE, SECTION, REQUIRE
+#elif (_CATCH_VERSION_MAJOR == 2)
+  #include <catch2/catch.hpp>
+#endif
+
+#if __cplusplus >= 201703L
+
+#include "typeName.hh"
+#include "typeRegistry.hh"
+
+#include <cstddef>      // size_t
+#include <cstdint>      // uint64_t
+#include <string>
+#include <utility>      // index_sequence
+
+namespace {
+
+template <std::size_t N>
+struct Tag {};
+
+template <typename T>
+int handle() { return static_cast<int>(sizeof(T)); }
+
+template <std::size_t ...Is>
+constexpr bool allFound(std::index_sequence<Is...>) {
+    using Registry = TypeRegistry<Tag<Is>...>;
+    return ((Registry::template indexOf<Tag<Is>>() == Is) && ...);
+}
+
+}  // namespace
+
+TEST_CASE("Type IDs from type names",
+          "[typeId]")
+{
+    SECTION("IDs are the FNV-1a hashes of the names, at compile time")
+    {
+        static_assert(typeId<int>() == impl::fnv1a64(typeName<int>()));
+        static_assert(impl::fnv1a64("") == 0xcbf29ce484222325);
+        static_assert(impl::fnv1a64("a") == 0xaf63dc4c8601ec8c);
+        REQUIRE(typeId<const int&>() == impl::fnv1a64("const int&"));
+    }
+    SECTION("Distinct types have distinct IDs")
+    {
+        static_assert(typeId<int>() != typeId<const int>());
+        static_assert(typeId<int>() != typeId<unsigned int>());
+        static_assert(typeId<int*>() != typeId<int&>());
+        static_assert(typeId<Tag<1>>() != typeId<Tag<2>>());
+    }
+}
+
+TEST_CASE("Perfect-hash registries of types",
+          "[TypeRegistry]")
+{
+    SECTION("Each type maps to its index, others to npos")
+    {
+        using Registry = TypeRegistry<int, double, std::string, char*>;
+        static_assert(Registry::type_ct == 4);
+        static_assert(Registry::indexOf<int>() == 0);
+        static_assert(Registry::indexOf<double>() == 1);
+        static_assert(Registry::indexOf<std::string>() == 2);
+        static_assert(Registry::indexOf<char*>() == 3);
+        static_assert(Registry::indexOf<float>() == Registry::npos);
+        static_assert(!Registry::contains(typeId<const int>()));
+        REQUIRE(Registry::contains(typeId<double>()));
+        REQUIRE(!Registry::contains(0));
+        const std::size_t slot_ct { Registry::slotCount() };
+        REQUIRE(slot_ct >= Registry::type_ct);
+        REQUIRE((slot_ct & (slot_ct - 1)) == 0);
+    }
+    SECTION("Larger and degenerate type lists")
+    {
+        static_assert(allFound(std::make_index_sequence<1> {}));
+        static_assert(allFound(std::make_index_sequence<64> {}));
+        static_assert(TypeRegistry<>::indexOf<int>() == TypeRegistry<>::npos);
+        REQUIRE(TypeRegistry<Tag<0>>::indexOf<Tag<0>>() == 0);
+    }
+}
+
+TEST_CASE("Dispatch by type ID with TypeMap",
+          "[TypeMap]")
+{
+    using Handler = int (*)();
+    constexpr TypeMap<Handler, char, short, int, long long> handlers {
+        &handle<char>, &handle<short>, &handle<int>, &handle<long long> };
+
+    SECTION("Found by ID or type")
+    {
+        REQUIRE(handlers.find(typeId<char>()) != nullptr);
+        REQUIRE((*handlers.find(typeId<char>()))() == 1);
+        REQUIRE((*handlers.find(typeId<short>()))() == 2);
+        REQUIRE(handlers.get<int>()() == 4);
+        REQUIRE(handlers.get<long long>()() == 8);
+        static_assert(handlers.get<int>() == &handle<int>);
+    }
+    SECTION("Unknown IDs, including that of unused slots, find nothing")
+    {
+        REQUIRE(handlers.find(typeId<double>()) == nullptr);
+        REQUIRE(handlers.find(0) == nullptr);
+    }
+    SECTION("Values need not be trivial")
+    {
+        const TypeMap<std::string, int, double> names {
+            "integer", "floating point" };
+        REQUIRE(names.get<int>() == "integer");
+        REQUIRE(*names.find(typeId<double>()) == "floating point");
+    }
+}
+
+#endif  // C++17 and above